@@ -0,0 +1,427 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		neighbor_range.h
+*	@brief		Adjacency list ranges over SP slots, LP chains and overflow lists; PageDB vertex ranges
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_NEIGHBOR_RANGE_H_
+#define _GSTREAM_DATATYPE_NEIGHBOR_RANGE_H_
+
+#include <gstream/datatype/slotted_page.h>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/* ---------------------------------------------------------------
+**
+** neighbors(store, page_id, slot_offset [, overflow_pages])
+** A single-pass range of adj_list_elem_t over the whole adjacency
+** list of a vertex, whatever its layout:
+**  - small page:  list(slot), record_size(slot) elements
+**  - large page:  list(0) of the LP_HEAD page, then list_ext(0) of
+**                 every following LP_EXTENDED page, until the record
+**                 size stored in the head is consumed
+**  - overflow:    the lists of the owner vertex in the overflow
+**                 chain of the (head) page, if the overflow store
+**                 (pagedb_updater) is given
+**  - elided:      a vertex without a slot in a small page (zero-
+**                 degree elision, pagedb.h) has an empty list
+** The iterator walks one contiguous segment with a pointer; the
+** segment switch is out of the element loop:
+**     operator++: if (++cur == segment_end) skip_segment();
+** and the chain state is kept in the range, apart from (cur,
+** segment_end), so a range-for compiles to the same pointer loop as
+** hand-written code, plus one branch per segment (checked with g++
+** -O2: the element loop is load, add, increment, compare).
+**
+** vertices(store, rid_table)
+** A forward range of vertex_ref over every vertex of the base pages
+** in page order (one per slot of a small page, one per LP chain;
+** elided zero-degree vertices are not visited);
+** vertex_ref::neighbors() is the range above.
+**
+** store is any page store with operator[](page_id) -> page_t&
+** (std::vector<page_t>, numa_page_store, mapped_page_store).
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+template <typename PageStoreTy>
+struct page_store_traits {
+	using page_t = typename std::decay<decltype(std::declval<PageStoreTy&>()[0])>::type;
+};
+
+/// Cursor over the segments which follow the current one (LP extended pages, then spilled lists)
+template <typename PageStoreTy>
+struct neighbor_segment_cursor {
+	using page_t = typename page_store_traits<PageStoreTy>::page_t;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(page_t);
+	using segment_t = std::pair<const adj_list_elem_t*, const adj_list_elem_t*>;
+
+	// Trivial on purpose (no member initializers): a range sets the members it uses,
+	// the store and the LP/overflow members only for a chained list
+	PageStoreTy* store;
+	page_t*      overflow_pages;
+	std::size_t  next_page;  // next LP_EXTENDED page of the chain
+	std::size_t  remaining;  // LP elements in the following extended pages
+	vertex_id_t  owner;      // vertex id of the owner of the list
+	uint32_t     link;       // overflow page of the next spilled segments (1-based)
+	offset_t     spill_slot; // next slot of the overflow page overflow_pages[link - 1]
+
+	inline bool is_chained() const
+	{
+		return remaining != 0 || link != 0;
+	}
+	/// Next: the next non-empty segment; (nullptr, nullptr) after the last one
+	inline segment_t next()
+	{
+		if (!is_chained())
+			return segment_t{ nullptr, nullptr }; // the common case: the list had one segment
+		return next_chained();
+	}
+	segment_t next_chained();
+};
+
+template <typename PageStoreTy>
+typename neighbor_segment_cursor<PageStoreTy>::segment_t neighbor_segment_cursor<PageStoreTy>::next_chained()
+{
+	while (remaining > 0) {
+		page_t& ext = (*store)[next_page++];
+		std::size_t count = ext.footer.front / sizeof(adj_list_elem_t);
+		if (count > remaining)
+			count = remaining;
+		remaining -= count;
+		if (count > 0)
+			return segment_t{ ext.list_ext(static_cast<offset_t>(0)), ext.list_ext(static_cast<offset_t>(0)) + count };
+	}
+	while (link != 0) {
+		page_t& spill = overflow_pages[link - 1];
+		while (spill_slot < spill.number_of_slots()) {
+			const offset_t s = spill_slot++;
+			const std::size_t count = static_cast<std::size_t>(spill.record_size(s));
+			if (count > 0 && spill.slot(s).vertex_id == owner)
+				return segment_t{ spill.list(s), spill.list(s) + count };
+		}
+		link = spill.overflow_link();
+		spill_slot = 0;
+	}
+	return segment_t{ nullptr, nullptr };
+}
+
+template <typename PageStoreTy>
+class neighbor_iterator {
+public:
+	using cursor_t = neighbor_segment_cursor<PageStoreTy>;
+	using page_t = typename cursor_t::page_t;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(page_t);
+
+	// Single pass: the iterators of a range share its segment cursor
+	using iterator_category = std::input_iterator_tag;
+	using value_type = adj_list_elem_t;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const adj_list_elem_t*;
+	using reference = const adj_list_elem_t&;
+
+	/// End iterator
+	neighbor_iterator() = default;
+	neighbor_iterator(pointer first, pointer last, cursor_t* cursor_) :
+		cur{ first },
+		segment_end{ last },
+		cursor{ cursor_ }
+	{
+	}
+
+	inline reference operator*() const
+	{
+		return *cur;
+	}
+	inline pointer operator->() const
+	{
+		return cur;
+	}
+	inline neighbor_iterator& operator++()
+	{
+		if (++cur == segment_end)
+			skip_segment();
+		return *this;
+	}
+	inline bool operator==(const neighbor_iterator& other) const
+	{
+		return cur == other.cur;
+	}
+	inline bool operator!=(const neighbor_iterator& other) const
+	{
+		return cur != other.cur;
+	}
+
+	/// Segment: the contiguous rest of the current page list, [cur, segment_end)
+	inline std::pair<pointer, pointer> segment() const
+	{
+		return std::make_pair(cur, segment_end);
+	}
+	/// Skip segment: moves to the first element of the next segment
+	inline void skip_segment()
+	{
+		const auto next = cursor->next();
+		cur = next.first;
+		segment_end = next.second;
+	}
+
+protected:
+	// The chain state lives in the range: only the cursor escapes to next_chained(),
+	// cur and segment_end stay in registers in the element loop
+	const adj_list_elem_t* cur{ nullptr };
+	const adj_list_elem_t* segment_end{ nullptr };
+	cursor_t*              cursor{ nullptr };
+};
+
+template <typename PageStoreTy>
+class neighbor_range {
+public:
+	using iterator = neighbor_iterator<PageStoreTy>;
+	using const_iterator = iterator;
+	using cursor_t = typename iterator::cursor_t;
+	using page_t = typename iterator::page_t;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(page_t);
+
+	neighbor_range(PageStoreTy& store, page_id_t page_id, slot_offset_t slot_offset, page_t* overflow_pages = nullptr);
+
+	/// Begin: restarts the traversal; one traversal of a range at a time
+	inline iterator begin() const
+	{
+		if (!start.is_chained())
+			return iterator{ first, first_end, &start }; // next() does not modify an unchained cursor
+		cursor = start;
+		return iterator{ first, first_end, &cursor };
+	}
+	inline iterator end() const
+	{
+		return iterator{};
+	}
+	inline bool empty() const
+	{
+		return first == nullptr;
+	}
+	/// Size: walks the segments (not the elements)
+	std::size_t size() const
+	{
+		std::size_t n = 0;
+		for (iterator it = begin(); it != end(); it.skip_segment())
+			n += static_cast<std::size_t>(it.segment().second - it.segment().first);
+		return n;
+	}
+
+protected:
+	const adj_list_elem_t* first;
+	const adj_list_elem_t* first_end;
+	mutable cursor_t       start;  // the cursor after the first segment
+	mutable cursor_t       cursor; // the cursor of the current traversal (chained lists)
+};
+
+#define NEIGHBOR_RANGE_TEMPLATE template <typename PageStoreTy>
+#define NEIGHBOR_RANGE neighbor_range<PageStoreTy>
+
+NEIGHBOR_RANGE_TEMPLATE
+NEIGHBOR_RANGE::neighbor_range(PageStoreTy& store, page_id_t page_id, slot_offset_t slot_offset, page_t* overflow_pages)
+{
+	page_t& page = store[page_id];
+	start.store = &store;
+	start.remaining = 0;
+	start.link = 0;
+	// The slot of the vertex: slot_offset is its offset in the vertex range of the page
+	const offset_t slot = page.is_lp_head() ? static_cast<offset_t>(0) : page.slot_of(slot_offset);
+	if (!page.is_lp_head() && slot >= page.number_of_slots()) {
+		// An elided vertex of a small page (zero-degree elision): no list
+		first = nullptr;
+		first_end = nullptr;
+		return;
+	}
+	if (overflow_pages != nullptr) {
+		start.overflow_pages = overflow_pages;
+		start.owner = page.slot(slot).vertex_id;
+		start.link = page.overflow_link();
+		start.spill_slot = 0;
+	}
+	std::size_t count;
+	if (page.is_lp_head()) {
+		count = (page.footer.front - sizeof(record_size_t)) / sizeof(adj_list_elem_t);
+		const std::size_t total = static_cast<std::size_t>(page.record_size(static_cast<offset_t>(0)));
+		start.remaining = (total > count) ? total - count : 0;
+		start.next_page = static_cast<std::size_t>(page_id) + 1;
+		first = page.list(static_cast<offset_t>(0));
+	}
+	else {
+		count = static_cast<std::size_t>(page.record_size(slot));
+		first = page.list(slot);
+	}
+	first_end = first + count;
+	if (count == 0) {
+		const auto next = start.next();
+		first = next.first;
+		first_end = next.second;
+	}
+}
+
+#undef NEIGHBOR_RANGE
+#undef NEIGHBOR_RANGE_TEMPLATE
+
+/// Neighbors: the adjacency list of the vertex at (page_id, slot_offset); page_id is the head page of an LP vertex
+template <typename PageStoreTy>
+inline neighbor_range<PageStoreTy> neighbors(PageStoreTy& store, typename neighbor_range<PageStoreTy>::page_id_t page_id,
+	typename neighbor_range<PageStoreTy>::slot_offset_t slot_offset, typename neighbor_range<PageStoreTy>::page_t* overflow_pages = nullptr)
+{
+	return neighbor_range<PageStoreTy>{ store, page_id, slot_offset, overflow_pages };
+}
+
+template <typename PageStoreTy>
+struct vertex_ref {
+	using page_t = typename page_store_traits<PageStoreTy>::page_t;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(page_t);
+
+	vertex_id_t   vertex_id;
+	page_id_t     page_id;
+	slot_offset_t slot_offset;
+	PageStoreTy*  store;
+	page_t*       overflow_pages;
+
+	inline bool is_lp() const
+	{
+		return (*store)[page_id].is_lp_head();
+	}
+	inline neighbor_range<PageStoreTy> neighbors() const
+	{
+		return neighbor_range<PageStoreTy>{ *store, page_id, slot_offset, overflow_pages };
+	}
+};
+
+template <typename PageStoreTy, typename RIDTableTy>
+class vertex_iterator {
+public:
+	using value_type = vertex_ref<PageStoreTy>;
+	using page_t = typename value_type::page_t;
+	using iterator_category = std::forward_iterator_tag;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const value_type*;
+	using reference = const value_type&;
+
+	vertex_iterator(PageStoreTy& store, const RIDTableTy& rid_table_, std::size_t page_id, page_t* overflow_pages) :
+		rid_table{ &rid_table_ },
+		num_slots{ 0 },
+		pid{ 0 },
+		slot{ 0 }
+	{
+		ref.store = &store;
+		ref.overflow_pages = overflow_pages;
+		seek(page_id);
+	}
+
+	inline reference operator*() const
+	{
+		return ref;
+	}
+	inline pointer operator->() const
+	{
+		return &ref;
+	}
+	inline vertex_iterator& operator++()
+	{
+		// The cursor is a std::size_t: a slot_offset_t sized for the slots of a full page wraps past its last slot
+		if (++slot < num_slots) {
+			ref.vertex_id = (*ref.store)[pid].slot(static_cast<typename value_type::offset_t>(slot)).vertex_id;
+			// The offset in the vertex range of the page: the slot itself unless vertices are elided
+			ref.slot_offset = static_cast<typename value_type::slot_offset_t>(ref.vertex_id - (*rid_table)[pid].start_vid);
+		}
+		else {
+			seek(pid + 1 + static_cast<std::size_t>((*rid_table)[pid].auxiliary));
+		}
+		return *this;
+	}
+	inline vertex_iterator operator++(int)
+	{
+		vertex_iterator prev = *this;
+		++(*this);
+		return prev;
+	}
+	inline bool operator==(const vertex_iterator& other) const
+	{
+		return pid == other.pid && slot == other.slot;
+	}
+	inline bool operator!=(const vertex_iterator& other) const
+	{
+		return !(*this == other);
+	}
+
+protected:
+	// First vertex of the first non-empty page at or after page_id (SP: slots, LP head: one vertex)
+	void seek(std::size_t page_id)
+	{
+		const std::size_t num_pages = rid_table->size();
+		for (; page_id < num_pages; page_id += 1 + static_cast<std::size_t>((*rid_table)[page_id].auxiliary)) {
+			page_t& page = (*ref.store)[page_id];
+			num_slots = page.is_lp_head() ? 1 : static_cast<std::size_t>(page.number_of_slots());
+			if (num_slots == 0)
+				continue;
+			pid = page_id;
+			slot = 0;
+			ref.page_id = static_cast<typename value_type::page_id_t>(page_id);
+			ref.slot_offset = 0;
+			ref.vertex_id = page.slot(static_cast<typename value_type::offset_t>(0)).vertex_id;
+			return;
+		}
+		pid = num_pages; // the end; ref is not read there (num_pages may not fit in page_id_t)
+		slot = 0;
+		num_slots = 0;
+	}
+
+	value_type        ref;
+	const RIDTableTy* rid_table;
+	std::size_t       num_slots;
+	std::size_t       pid;  // ref.page_id
+	std::size_t       slot; // the slot of ref in the page
+};
+
+template <typename PageStoreTy, typename RIDTableTy>
+class vertex_range {
+public:
+	using iterator = vertex_iterator<PageStoreTy, RIDTableTy>;
+	using const_iterator = iterator;
+	using page_t = typename iterator::page_t;
+
+	/// rid_table: the RID table of the base pages; rid_table.size() is the number of base pages
+	vertex_range(PageStoreTy& store_, const RIDTableTy& rid_table_, page_t* overflow_pages_ = nullptr) :
+		store(store_),
+		rid_table(rid_table_),
+		overflow_pages(overflow_pages_)
+	{
+	}
+	inline iterator begin() const
+	{
+		return iterator{ store, rid_table, 0, overflow_pages };
+	}
+	inline iterator end() const
+	{
+		return iterator{ store, rid_table, rid_table.size(), overflow_pages };
+	}
+
+protected:
+	PageStoreTy&      store;
+	const RIDTableTy& rid_table;
+	page_t*           overflow_pages;
+};
+
+/// Vertices: every vertex of the base pages, in page order
+template <typename PageStoreTy, typename RIDTableTy>
+inline vertex_range<PageStoreTy, RIDTableTy> vertices(PageStoreTy& store, const RIDTableTy& rid_table,
+	typename vertex_range<PageStoreTy, RIDTableTy>::page_t* overflow_pages = nullptr)
+{
+	return vertex_range<PageStoreTy, RIDTableTy>{ store, rid_table, overflow_pages };
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_NEIGHBOR_RANGE_H_
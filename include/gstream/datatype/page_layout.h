@@ -0,0 +1,337 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		page_layout.h
+*	@brief		Page layout planner: id widths and page size from graph statistics
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGE_LAYOUT_H_
+#define _GSTREAM_DATATYPE_PAGE_LAYOUT_H_
+
+#include <gstream/datatype/pagedb.h>
+#include <cstdint>
+#include <ostream>
+
+/* ---------------------------------------------------------------
+**
+** Page layout planner
+** The id types of a slotted page are chosen by hand: too wide wastes
+** bytes on every edge (adj_list_elem_t is stored |E| times), too
+** narrow silently wraps (get_slot_offset(), vid_to_pid() and the
+** generators cast without checks).
+** plan_page_layout(stats) returns, for every power-of-two page size
+** in [min_page_size, max_page_size], the narrowest unsigned widths
+** (1, 2, 4 or 8 bytes) which are safe for the graph, and keeps the
+** page size with the smallest estimated PageDB:
+**     vertex_id_t     first_vid + |V| - 1
+**     record_size_t   max degree (the record of an LP head)
+**     offset_t        DataSectionSize (footer front/rear)
+**     record_offset_t DataSectionSize
+**     slot_offset_t   slots per page - 1 (elision: |V| - 1)
+**     page_id_t       an upper bound of the number of pages - 1
+** The sizes are those of __GSTREAM_SLOTTED_PAGE_TEMPLATE_CONSTDEFS,
+** computed from widths by the constexpr helpers below, so a plan is
+** a constant expression when the statistics are. The helpers are
+** single-return (C++11) constexpr functions: the v140 toolset
+** (Visual Studio 2015) does not accept loops in constexpr bodies.
+** Page bound: two consecutive small pages hold more than a data
+** section (the first vertex of the second one did not fit in the
+** first), and a large page chain wastes less than one page:
+**     pages <= 2 * ceil(bytes / DataSectionSize) + 2 * num_lp + 1
+** with num_lp <= |E| / (MaximumEdgesInHeadPage + 1). A page size is
+** a candidate if a slot and its record size take at most half of the
+** data section with one edge.
+** Estimate: the bytes over the data sections, where every small page
+** also loses half a record of the average degree to the greedy
+** packing, plus the chain of the largest vertex.
+**
+** planned_slotted_page<...> maps the widths of a constexpr plan to
+** the slotted_page instantiation; GSTREAM_PLANNED_PAGE(layout, ...)
+** spells it out. write_page_instantiation() prints the generator
+** instantiation for a plan computed at run time (code generation).
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+struct graph_stats {
+	std::uint64_t num_vertices;
+	std::uint64_t num_edges;
+	std::uint64_t max_degree;
+	std::uint64_t edge_payload_size;   // 0: void
+	std::uint64_t vertex_payload_size; // 0: void
+	std::uint64_t first_vid;
+	bool          zero_degree_elision; // slot offsets address the whole vertex range of a page (pagedb.h)
+};
+
+namespace _page_layout {
+
+/// Width: the narrowest of 1, 2, 4, 8 bytes which holds max_value
+constexpr std::size_t width_for(std::uint64_t max_value)
+{
+	return (max_value <= 0xFFull) ? 1 : (max_value <= 0xFFFFull) ? 2 : (max_value <= 0xFFFFFFFFull) ? 4 : 8;
+}
+
+constexpr std::uint64_t max_of_width(std::size_t width)
+{
+	return (width >= 8) ? ~0ull : ((1ull << (8 * width)) - 1);
+}
+
+constexpr std::uint64_t div_ceil(std::uint64_t a, std::uint64_t b)
+{
+	return (a + b - 1) / b;
+}
+
+// Mirrors of __GSTREAM_SLOTTED_PAGE_TEMPLATE_CONSTDEFS
+constexpr std::size_t footer_size(std::size_t offset_width)
+{
+	return sizeof(std::uint32_t) + sizeof(std::uint32_t) + 2 * offset_width;
+}
+
+constexpr std::size_t data_section_size(std::size_t page_size, std::size_t offset_width)
+{
+	return page_size - footer_size(offset_width);
+}
+
+constexpr std::size_t slot_size(std::size_t vertex_id_width, std::size_t record_offset_width, std::size_t vertex_payload_size)
+{
+	return vertex_id_width + record_offset_width + vertex_payload_size;
+}
+
+constexpr std::size_t adj_list_elem_size(std::size_t page_id_width, std::size_t slot_offset_width, std::size_t edge_payload_size)
+{
+	return page_id_width + slot_offset_width + edge_payload_size;
+}
+
+constexpr std::size_t maximum_edges_in_head_page(std::size_t data_section, std::size_t slot, std::size_t record_size_width, std::size_t elem)
+{
+	return (data_section - slot - record_size_width) / elem;
+}
+
+constexpr std::size_t maximum_edges_in_ext_page(std::size_t data_section, std::size_t slot, std::size_t elem)
+{
+	return (data_section - slot) / elem;
+}
+
+/// Page bound (see above); valid if 2 * (slot + record_size + elem) <= data_section
+constexpr std::uint64_t max_pages(const graph_stats& stats, std::size_t data_section, std::size_t slot, std::size_t record_size_width, std::size_t elem)
+{
+	return 2 * div_ceil(((stats.num_vertices > 0) ? stats.num_vertices : 1) * (slot + record_size_width) + stats.num_edges * elem, data_section)
+		+ 2 * (stats.num_edges / (maximum_edges_in_head_page(data_section, slot, record_size_width, elem) + 1)) + 1;
+}
+
+} // !namespace _page_layout
+
+struct page_layout {
+	std::size_t page_size; // 0: no candidate page size fits the graph
+	std::size_t vertex_id_width;
+	std::size_t page_id_width;
+	std::size_t record_offset_width;
+	std::size_t slot_offset_width;
+	std::size_t record_size_width;
+	std::size_t offset_width;
+	std::size_t edge_payload_size;
+	std::size_t vertex_payload_size;
+	std::uint64_t estimated_pages;
+	std::uint64_t max_pages; // the bound page_id_t is sized for
+
+	inline constexpr bool valid() const
+	{
+		return page_size != 0;
+	}
+	inline constexpr std::size_t data_section_size() const
+	{
+		return _page_layout::data_section_size(page_size, offset_width);
+	}
+	inline constexpr std::size_t slot_size() const
+	{
+		return _page_layout::slot_size(vertex_id_width, record_offset_width, vertex_payload_size);
+	}
+	inline constexpr std::size_t adj_list_elem_size() const
+	{
+		return _page_layout::adj_list_elem_size(page_id_width, slot_offset_width, edge_payload_size);
+	}
+	inline constexpr std::size_t maximum_edges_in_head_page() const
+	{
+		return _page_layout::maximum_edges_in_head_page(data_section_size(), slot_size(), record_size_width, adj_list_elem_size());
+	}
+	inline constexpr std::size_t maximum_edges_in_ext_page() const
+	{
+		return _page_layout::maximum_edges_in_ext_page(data_section_size(), slot_size(), adj_list_elem_size());
+	}
+	inline constexpr std::uint64_t estimated_bytes() const
+	{
+		return estimated_pages * page_size;
+	}
+};
+
+namespace _page_layout {
+
+constexpr std::uint64_t vertex_count(const graph_stats& stats)
+{
+	return (stats.num_vertices > 0) ? stats.num_vertices : 1;
+}
+
+constexpr page_layout no_layout(const graph_stats& stats)
+{
+	return page_layout{ 0, 0, 0, 0, 0, 0, 0, static_cast<std::size_t>(stats.edge_payload_size), static_cast<std::size_t>(stats.vertex_payload_size), 0, 0 };
+}
+
+/// offset_t and record_offset_t hold the data section size, which depends on the footer (offset_t): the narrowest width from 'width' up
+constexpr std::size_t offset_width_for(std::size_t page_size, std::size_t width = 1)
+{
+	return (width < 8 && (page_size <= footer_size(width) || data_section_size(page_size, width) > max_of_width(width)))
+		? offset_width_for(page_size, width * 2)
+		: width;
+}
+
+constexpr std::uint64_t max_slot_offset(const graph_stats& stats, std::size_t data_section, std::size_t slot, std::size_t record_size_width)
+{
+	return stats.zero_degree_elision
+		? vertex_count(stats) - 1
+		: ((data_section / (slot + record_size_width) > 0) ? data_section / (slot + record_size_width) - 1 : 0);
+}
+
+/// Estimate (see above): half an average record lost per small page, plus the chain of the largest vertex
+constexpr std::uint64_t small_page_waste(const graph_stats& stats, std::size_t data_section, std::size_t slot, std::size_t record_size_width, std::size_t elem)
+{
+	return ((stats.num_edges / vertex_count(stats) * elem + slot + record_size_width) / 2 < data_section / 2)
+		? (stats.num_edges / vertex_count(stats) * elem + slot + record_size_width) / 2
+		: data_section / 2;
+}
+
+constexpr std::uint64_t estimate_pages(const graph_stats& stats, std::size_t data_section, std::size_t slot, std::size_t record_size_width, std::size_t elem)
+{
+	return div_ceil(vertex_count(stats) * (slot + record_size_width) + stats.num_edges * elem, data_section - small_page_waste(stats, data_section, slot, record_size_width, elem))
+		+ ((stats.max_degree > maximum_edges_in_head_page(data_section, slot, record_size_width, elem))
+			? 1 + div_ceil(stats.max_degree - maximum_edges_in_head_page(data_section, slot, record_size_width, elem), maximum_edges_in_ext_page(data_section, slot, elem))
+			: 0);
+}
+
+// l with page_id_t and the page counts set
+constexpr page_layout with_page_id(const page_layout& l, std::size_t page_id_width, std::uint64_t bound, std::uint64_t estimated)
+{
+	return page_layout{ l.page_size, l.vertex_id_width, page_id_width, l.record_offset_width, l.slot_offset_width, l.record_size_width, l.offset_width,
+		l.edge_payload_size, l.vertex_payload_size, (estimated < bound) ? estimated : bound, bound };
+}
+
+/// page_id_t: the narrowest width from page_id_width up whose elements still fit the page bound it implies
+// (l: every width but page_id_t; page_size = 0 in the result if the page size is not a candidate)
+constexpr page_layout plan_page_id(const graph_stats& stats, const page_layout& l, std::size_t page_id_width)
+{
+	return (page_id_width > 8 || 2 * (l.slot_size() + l.record_size_width + adj_list_elem_size(page_id_width, l.slot_offset_width, l.edge_payload_size)) > l.data_section_size())
+		? no_layout(stats) // not a candidate: a wider page_id_t does not help
+		: (max_pages(stats, l.data_section_size(), l.slot_size(), l.record_size_width, adj_list_elem_size(page_id_width, l.slot_offset_width, l.edge_payload_size)) - 1 > max_of_width(page_id_width))
+		? plan_page_id(stats, l, page_id_width * 2)
+		: with_page_id(l, page_id_width,
+			max_pages(stats, l.data_section_size(), l.slot_size(), l.record_size_width, adj_list_elem_size(page_id_width, l.slot_offset_width, l.edge_payload_size)),
+			estimate_pages(stats, l.data_section_size(), l.slot_size(), l.record_size_width, adj_list_elem_size(page_id_width, l.slot_offset_width, l.edge_payload_size)));
+}
+
+constexpr page_layout plan_widths(const graph_stats& stats, std::size_t page_size, std::size_t offset_width, std::size_t vertex_id_width, std::size_t record_offset_width, std::size_t record_size_width)
+{
+	return plan_page_id(stats, page_layout{ page_size, vertex_id_width, 0, record_offset_width,
+		width_for(max_slot_offset(stats, data_section_size(page_size, offset_width), slot_size(vertex_id_width, record_offset_width, static_cast<std::size_t>(stats.vertex_payload_size)), record_size_width)),
+		record_size_width, offset_width, static_cast<std::size_t>(stats.edge_payload_size), static_cast<std::size_t>(stats.vertex_payload_size), 0, 0 }, 1);
+}
+
+// The layout of one page size; page_size = 0 if it is not a candidate
+constexpr page_layout plan_for_page_size(const graph_stats& stats, std::size_t page_size)
+{
+	return (page_size <= footer_size(offset_width_for(page_size)))
+		? no_layout(stats)
+		: plan_widths(stats, page_size, offset_width_for(page_size),
+			width_for(stats.first_vid + vertex_count(stats) - 1),
+			width_for(data_section_size(page_size, offset_width_for(page_size))),
+			width_for(stats.max_degree));
+}
+
+constexpr page_layout better_layout(const page_layout& best, const page_layout& layout)
+{
+	return (layout.valid() && (!best.valid() || layout.estimated_bytes() < best.estimated_bytes())) ? layout : best;
+}
+
+constexpr page_layout plan_from(const graph_stats& stats, std::size_t page_size, std::size_t max_page_size, const page_layout& best)
+{
+	return (page_size == 0 || page_size > max_page_size)
+		? best
+		: plan_from(stats, page_size * 2, max_page_size, better_layout(best, plan_for_page_size(stats, page_size)));
+}
+
+} // !namespace _page_layout
+
+/// Plan: the smallest estimated layout over the power-of-two page sizes in [min_page_size, max_page_size]; !valid() if none fits
+constexpr page_layout plan_page_layout(const graph_stats& stats, std::size_t min_page_size = 4 * SIZE_1KB, std::size_t max_page_size = SIZE_1MB)
+{
+	return _page_layout::plan_from(stats, min_page_size, max_page_size, page_layout{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+}
+
+/// Fits: whether the id types of PageTy are wide enough for the graph (e.g. a hand-written instantiation)
+template <typename PageTy>
+constexpr bool page_layout_fits(const graph_stats& stats)
+{
+	using traits_t = page_traits<PageTy>;
+	using record_size_t = typename traits_t::record_size_t;
+	return 2 * (sizeof(typename traits_t::slot_t) + sizeof(record_size_t) + sizeof(typename traits_t::adj_list_elem_t)) <= traits_t::DataSectionSize
+		&& sizeof(typename traits_t::vertex_id_t) >= _page_layout::width_for(stats.first_vid + _page_layout::vertex_count(stats) - 1)
+		&& sizeof(typename traits_t::page_id_t) >= _page_layout::width_for(_page_layout::max_pages(stats, traits_t::DataSectionSize,
+			sizeof(typename traits_t::slot_t), sizeof(record_size_t), sizeof(typename traits_t::adj_list_elem_t)) - 1)
+		&& sizeof(typename traits_t::record_offset_t) >= _page_layout::width_for(traits_t::DataSectionSize)
+		&& sizeof(typename traits_t::slot_offset_t) >= _page_layout::width_for(_page_layout::max_slot_offset(stats, traits_t::DataSectionSize,
+			sizeof(typename traits_t::slot_t), sizeof(record_size_t)))
+		&& sizeof(record_size_t) >= _page_layout::width_for(stats.max_degree)
+		&& sizeof(typename traits_t::offset_t) >= _page_layout::width_for(traits_t::DataSectionSize);
+}
+
+template <std::size_t Width> struct uint_of_width;
+template <> struct uint_of_width<1> { using type = std::uint8_t; };
+template <> struct uint_of_width<2> { using type = std::uint16_t; };
+template <> struct uint_of_width<4> { using type = std::uint32_t; };
+template <> struct uint_of_width<8> { using type = std::uint64_t; };
+
+/// Planned slotted page: the slotted_page of the widths of a plan
+template <std::size_t VertexIdWidth, std::size_t PageIdWidth, std::size_t RecordOffsetWidth, std::size_t SlotOffsetWidth, std::size_t RecordSizeWidth,
+	std::size_t PageSize, typename EdgePayloadTy = void, typename VertexPayloadTy = void, std::size_t OffsetWidth = sizeof(_slotted_page::default_offset_t)>
+using planned_slotted_page = slotted_page<
+	typename uint_of_width<VertexIdWidth>::type,
+	typename uint_of_width<PageIdWidth>::type,
+	typename uint_of_width<RecordOffsetWidth>::type,
+	typename uint_of_width<SlotOffsetWidth>::type,
+	typename uint_of_width<RecordSizeWidth>::type,
+	PageSize, EdgePayloadTy, VertexPayloadTy,
+	typename uint_of_width<OffsetWidth>::type>;
+
+/// The page type of a constexpr plan, e.g.
+//     constexpr page_layout layout = plan_page_layout(graph_stats{ ... });
+//     using page_t = GSTREAM_PLANNED_PAGE(layout, uint8_t, void);
+//     using traits_t = generator_traits<page_t>;
+#define GSTREAM_PLANNED_PAGE(LAYOUT, EDGE_PAYLOAD_T, VERTEX_PAYLOAD_T) \
+	::gstream::planned_slotted_page<(LAYOUT).vertex_id_width, (LAYOUT).page_id_width, (LAYOUT).record_offset_width, (LAYOUT).slot_offset_width,\
+		(LAYOUT).record_size_width, (LAYOUT).page_size, EDGE_PAYLOAD_T, VERTEX_PAYLOAD_T, (LAYOUT).offset_width>
+
+/// Write page instantiation: the generator_traits instantiation of a plan as C++ source (payload type names: "void" for none)
+inline void write_page_instantiation(std::ostream& os, const page_layout& layout, const char* edge_payload_type = "void", const char* vertex_payload_type = "void")
+{
+	auto uint_name = [](std::size_t width) -> const char* {
+		return (width == 1) ? "std::uint8_t" : (width == 2) ? "std::uint16_t" : (width == 4) ? "std::uint32_t" : "std::uint64_t";
+	};
+	os << "// page size " << layout.page_size << ", " << layout.adj_list_elem_size() << " bytes per edge, "
+		<< layout.slot_size() << " bytes per slot, ~" << layout.estimated_pages << " pages\n"
+		<< "using page_t = gstream::slotted_page<"
+		<< uint_name(layout.vertex_id_width) << ", "
+		<< uint_name(layout.page_id_width) << ", "
+		<< uint_name(layout.record_offset_width) << ", "
+		<< uint_name(layout.slot_offset_width) << ", "
+		<< uint_name(layout.record_size_width) << ", "
+		<< layout.page_size << ", "
+		<< edge_payload_type << ", "
+		<< vertex_payload_type << ", "
+		<< uint_name(layout.offset_width) << ">;\n"
+		<< "using generator_traits_t = gstream::generator_traits<page_t>;\n";
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGE_LAYOUT_H_
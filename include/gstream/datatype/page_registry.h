@@ -0,0 +1,229 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		page_registry.h
+*	@brief		PageDB layout files and a registry of page types dispatched at open time
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGE_REGISTRY_H_
+#define _GSTREAM_DATATYPE_PAGE_REGISTRY_H_
+
+#include <gstream/datatype/page_layout.h>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** Page type fingerprint
+** Everything which makes two slotted_page instantiations read a page
+** differently: the page size and the widths of the id, offset and
+** payload fields (and of the RID tuple auxiliary). The payload C++
+** types are not part of it: two layouts with the same sizes read the
+** same bytes.
+**
+** PageDB layout file
+** A .pages file is raw pages, without a header (read_pages(),
+** mapped_page_store and the existing PageDBs depend on it), so the
+** fingerprint is kept next to it, in a layout file:
+**     header { magic "PGDBLAYT", fingerprint, num_pages,
+**              num_vertices, first_vid, flags }
+** written by write_pagedb_layout<page_t>() with the PageDB.
+**
+** page_type_registry<HandlerTy, ResultTy(ArgsTy...)>
+** A table of fingerprint -> &HandlerTy<page_t>::run for the page
+** types compiled into the binary. open() reads the layout file and
+** returns the handler of its type (nullptr: invalid file or type not
+** registered); the handler is called once, and everything behind it
+** (page store, engine, queries) is compiled for that page type. The
+** only indirect call is at open time.
+**
+**     template <typename PageTy>
+**     struct bfs_handler {
+**         static std::size_t run(const char* pages_path, const char* rid_path);
+**     };
+**     page_type_registry<bfs_handler, std::size_t(const char*, const char*)> registry;
+**     registry.add_all<page_a_t, page_b_t, page_c_t>();
+**     pagedb_layout_header header;
+**     auto handler = registry.open("graph.layout", header);
+**     if (handler != nullptr)
+**         handler("graph.pages", "graph.rid_table");
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+namespace pagedb_layout_flag {
+constexpr std::uint64_t ZERO_DEGREE_ELISION = 0x01; // generated with zero-degree elision (pagedb.h)
+} // !namespace pagedb_layout_flag
+
+#pragma pack(push, 1)
+struct page_type_fingerprint {
+	std::uint64_t page_size;
+	std::uint8_t  vertex_id_size;
+	std::uint8_t  page_id_size;
+	std::uint8_t  record_offset_size;
+	std::uint8_t  slot_offset_size;
+	std::uint8_t  record_size_size;
+	std::uint8_t  offset_size;
+	std::uint8_t  rid_auxiliary_size;
+	std::uint8_t  reserved;
+	std::uint32_t edge_payload_size;
+	std::uint32_t vertex_payload_size;
+
+	inline constexpr bool operator==(const page_type_fingerprint& other) const
+	{
+		return page_size == other.page_size
+			&& vertex_id_size == other.vertex_id_size && page_id_size == other.page_id_size
+			&& record_offset_size == other.record_offset_size && slot_offset_size == other.slot_offset_size
+			&& record_size_size == other.record_size_size && offset_size == other.offset_size
+			&& rid_auxiliary_size == other.rid_auxiliary_size
+			&& edge_payload_size == other.edge_payload_size && vertex_payload_size == other.vertex_payload_size;
+	}
+	inline constexpr bool operator!=(const page_type_fingerprint& other) const
+	{
+		return !(*this == other);
+	}
+};
+
+struct pagedb_layout_header {
+	static constexpr std::uint64_t Magic = 0x5459414C42444750ull; // "PGDBLAYT"
+	std::uint64_t         magic;
+	page_type_fingerprint fingerprint;
+	std::uint64_t         num_pages;
+	std::uint64_t         num_vertices;
+	std::uint64_t         first_vid;
+	std::uint64_t         flags;
+};
+#pragma pack(pop)
+
+/// Fingerprint of a page type (RIDTuplePayloadTy: the auxiliary of its RID tuples)
+template <typename PageTy, typename RIDTuplePayloadTy = std::size_t>
+constexpr page_type_fingerprint fingerprint_of()
+{
+	using traits_t = page_traits<PageTy>;
+	return page_type_fingerprint{
+		static_cast<std::uint64_t>(traits_t::PageSize),
+		static_cast<std::uint8_t>(sizeof(typename traits_t::vertex_id_t)),
+		static_cast<std::uint8_t>(sizeof(typename traits_t::page_id_t)),
+		static_cast<std::uint8_t>(sizeof(typename traits_t::record_offset_t)),
+		static_cast<std::uint8_t>(sizeof(typename traits_t::slot_offset_t)),
+		static_cast<std::uint8_t>(sizeof(typename traits_t::record_size_t)),
+		static_cast<std::uint8_t>(sizeof(typename traits_t::offset_t)),
+		static_cast<std::uint8_t>(sizeof(RIDTuplePayloadTy)),
+		0,
+		static_cast<std::uint32_t>(traits_t::EdgePayloadSize),
+		static_cast<std::uint32_t>(traits_t::VertexPayloadSize) };
+}
+
+/// Fingerprint of a plan (page_layout.h): the page type GSTREAM_PLANNED_PAGE() makes of it
+constexpr page_type_fingerprint fingerprint_of(const page_layout& layout, std::size_t rid_auxiliary_size = sizeof(std::size_t))
+{
+	return page_type_fingerprint{
+		static_cast<std::uint64_t>(layout.page_size),
+		static_cast<std::uint8_t>(layout.vertex_id_width),
+		static_cast<std::uint8_t>(layout.page_id_width),
+		static_cast<std::uint8_t>(layout.record_offset_width),
+		static_cast<std::uint8_t>(layout.slot_offset_width),
+		static_cast<std::uint8_t>(layout.record_size_width),
+		static_cast<std::uint8_t>(layout.offset_width),
+		static_cast<std::uint8_t>(rid_auxiliary_size),
+		0,
+		static_cast<std::uint32_t>(layout.edge_payload_size),
+		static_cast<std::uint32_t>(layout.vertex_payload_size) };
+}
+
+/// Write PageDB layout: the layout file of a PageDB of PageTy pages
+template <typename PageTy, typename RIDTuplePayloadTy = std::size_t>
+bool write_pagedb_layout(const char* filepath, std::uint64_t num_pages, std::uint64_t num_vertices, std::uint64_t first_vid = 0, std::uint64_t flags = 0)
+{
+	std::ofstream ofs{ filepath, std::ios::out | std::ios::binary | std::ios::trunc };
+	if (!ofs.is_open())
+		return false;
+	pagedb_layout_header header;
+	memset(&header, 0, sizeof(pagedb_layout_header));
+	header.magic = pagedb_layout_header::Magic;
+	header.fingerprint = fingerprint_of<PageTy, RIDTuplePayloadTy>();
+	header.num_pages = num_pages;
+	header.num_vertices = num_vertices;
+	header.first_vid = first_vid;
+	header.flags = flags;
+	ofs.write(reinterpret_cast<const char*>(&header), sizeof(pagedb_layout_header));
+	ofs.flush();
+	return ofs.good();
+}
+
+inline bool read_pagedb_layout(const char* filepath, pagedb_layout_header& header)
+{
+	std::ifstream ifs{ filepath, std::ios::in | std::ios::binary };
+	ifs.read(reinterpret_cast<char*>(&header), sizeof(pagedb_layout_header));
+	return ifs.gcount() == sizeof(pagedb_layout_header) && header.magic == pagedb_layout_header::Magic;
+}
+
+template <template <typename _PageTy> class HandlerTy, typename SignatureTy>
+class page_type_registry;
+
+template <template <typename _PageTy> class HandlerTy, typename ResultTy, typename... ArgsTy>
+class page_type_registry<HandlerTy, ResultTy(ArgsTy...)> {
+public:
+	using handler_t = ResultTy(*)(ArgsTy...);
+	struct entry {
+		page_type_fingerprint fingerprint;
+		handler_t             handler;
+	};
+
+	/// Add: registers HandlerTy<PageTy>::run under the fingerprint of PageTy; false if another type has the same fingerprint
+	// The RID tables of the handlers are generator_traits<PageTy>::rid_table_t (std::size_t auxiliary)
+	template <typename PageTy>
+	bool add()
+	{
+		const page_type_fingerprint fingerprint = fingerprint_of<PageTy>();
+		if (find(fingerprint) != nullptr)
+			return false;
+		entries.push_back(entry{ fingerprint, &HandlerTy<PageTy>::run });
+		return true;
+	}
+	/// Add all: add<PageTy>() for every type of the list
+	template <typename... PageTys>
+	void add_all()
+	{
+		using expand = int[];
+		(void)expand{ 0, (this->template add<PageTys>(), 0)... };
+	}
+
+	/// Find: the handler of a fingerprint; nullptr if it is not registered
+	handler_t find(const page_type_fingerprint& fingerprint) const
+	{
+		for (const entry& e : entries)
+			if (e.fingerprint == fingerprint)
+				return e.handler;
+		return nullptr;
+	}
+	/// Open: reads the layout file of a PageDB into header and returns the handler of its page type;
+	// nullptr if the file is not a layout file or its type is not registered
+	handler_t open(const char* layout_path, pagedb_layout_header& header) const
+	{
+		if (!read_pagedb_layout(layout_path, header))
+			return nullptr;
+		return find(header.fingerprint);
+	}
+
+	inline std::size_t size() const
+	{
+		return entries.size();
+	}
+	inline const std::vector<entry>& registered() const
+	{
+		return entries;
+	}
+
+protected:
+	std::vector<entry> entries;
+};
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGE_REGISTRY_H_
@@ -11,10 +11,25 @@
 #define _GSTREAM_DATATYPE_PAGEDB_H_
 
 #include <gstream/datatype/slotted_page.h>
+#include <gstream/datatype/vertex_index.h>
+#include <gstream/io/page_writer.h>
+#include <gstream/memory/page_pool.h>
 #include <cstdio>
 #include <vector>
 #include <fstream>
+#include <string>
 #include <iterator>
+#include <thread>
+
+#if _WIN32 || _WIN64
+#ifndef NOMINMAX
+#define NOMINMAX // std::min/std::max in the rest of the library
+#endif
+#include <Windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace gstream {
 
@@ -102,14 +117,68 @@ struct page_traits {
 	ALIAS_SLOTTED_PAGE_TEMPLATE_CONSTDEFS(page_t);
 	using vertex_t = vertex_template<vertex_id_t, vertex_payload_t>;
 	using edge_t = edge_template<vertex_id_t, edge_payload_t>;
-	using page_builder_t = slotted_page_builder<vertex_id_t, page_id_t, record_offset_t, slot_offset_t, record_size_t, PageSize, edge_payload_t, vertex_payload_t>;
+	using page_builder_t = slotted_page_builder<vertex_id_t, page_id_t, record_offset_t, slot_offset_t, record_size_t, PageSize, edge_payload_t, vertex_payload_t, offset_t>;
 };
 
 enum class generator_error_t {
 	success,
 	init_failed_empty_edgeset,
+	write_failed,
+	checkpoint_failed,
+	resume_failed_invalid_checkpoint,
+	init_failed_empty_pagedb,
+	init_failed_elided_pagedb, // the tool needs every vertex to own a slot (zero-degree elision)
+	failed_field_overflow,     // a page id, overflow link or record size to be written does not fit in its field
+	init_failed_vertex_range,  // the given vertex count does not cover the vertices of the PageDB
 };
 
+/* ---------------------------------------------------------------
+**
+** Zero-degree vertex elision
+** A slot is owned by every vertex of a small page, even one without
+** a list: a graph with many isolated (or sink) vertices spends whole
+** pages on empty slots. With elision enabled, only the first vertex
+** of the vertex range of a small page [start_vid, next start_vid)
+** and its vertices with edges own a slot; every other vertex of the
+** range, wherever it is, has no slot, zero degree and the default
+** payload. Vertices are still addressed as (page, vid - start_vid),
+** so RID tables, adjacency list elements, the vertex index and every
+** state array indexed by vertex range are unchanged; the slots of a
+** page stay in vertex id order and are the record of which vertices
+** of the range have a list.
+** Packing (rid_table_generator, pagedb_generator, pagedb_from_csr):
+** - a zero-degree vertex opening a page gets a slot; any other one is
+**   elided into the range of the open page
+** - a vertex with edges takes a slot of the open page if it fits,
+**   otherwise it opens a new page
+** A small page with an elided vertex is flagged ELIDED_VERTICES (the
+** range of the last page is not in the RID table).
+** Readers find the slot of a vertex with slotted_page::slot_of(), a
+** search by vertex id on a flagged page, and treat a vertex without a
+** slot as an empty list (neighbor_range, neighbor_query_service, the
+** GAS engine, pagedb_csr_exporter). The update, transpose and
+** compaction tools expect every vertex to own a slot and fail with
+** init_failed_elided_pagedb on such a PageDB (has_elided_vertices());
+** the partitioner builds its shards from edges, without elision.
+**
+** ------------------------------------------------------------ */
+
+/// Has elided vertices: whether a small page of the PageDB does not own a slot for every vertex of its range
+template <typename PageContTy, typename RIDTableTy>
+bool has_elided_vertices(PageContTy& pages, const RIDTableTy& rid_table)
+{
+	for (std::size_t pid = 0; pid < rid_table.size(); ++pid) {
+		const auto& page = pages[pid];
+		if (!page.is_sp())
+			continue;
+		if (page.has_elided_vertices())
+			return true;
+		if (pid + 1 < rid_table.size() && static_cast<std::size_t>(rid_table[pid + 1].start_vid - rid_table[pid].start_vid) > static_cast<std::size_t>(page.number_of_slots()))
+			return true;
+	}
+	return false;
+}
+
 template <typename PageTy,
 	typename RIDTuplePayloadTy = std::size_t,
 	template <typename _ElemTy,
@@ -122,6 +191,7 @@ template <typename PageTy,
 		using page_builder_t = typename page_traits::page_builder_t;
 		ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(page_builder_t);
 		ALIAS_SLOTTED_PAGE_TEMPLATE_CONSTDEFS(page_builder_t);
+		using page_pool_t = page_pool<PageSize>;
 		using rid_tuple_t = rid_tuple_template<typename page_traits::vertex_id_t, RIDTuplePayloadTy>;
 		using cont_t = RIDTupleContTy<rid_tuple_t>;
 		using rid_table_t = cont_t;
@@ -136,6 +206,20 @@ template <typename PageTy,
 		};
 		generate_result generate(edge_iterator_t edge_iterator);
 		generate_result generate(edge_t* sorted_edges, ___size_t num_edges);
+		// Generate a RID table from the out-degrees of consecutive vertices [first_vid, first_vid + num_vertices)
+		template <typename DegreeTy>
+		generate_result generate(const DegreeTy* degrees, ___size_t num_vertices, vertex_id_t first_vid);
+		// Generate (parallel): the same table as generate(degrees, num_vertices, first_vid), byte for byte;
+		// num_threads = 0: std::thread::hardware_concurrency()
+		template <typename DegreeTy>
+		generate_result generate_parallel(const DegreeTy* degrees, ___size_t num_vertices, vertex_id_t first_vid, ___size_t num_threads = 0);
+
+		/// Zero-degree elision: zero-degree vertices of a small page do not own a slot (see above);
+		// the PageDB generator of the table must be configured the same way
+		inline void enable_zero_degree_elision(bool enabled = true)
+		{
+			elide_zero_degree = enabled;
+		}
 
 	protected:
 		void init();
@@ -150,7 +234,8 @@ template <typename PageTy,
 		vertex_id_t next_svid;
 		vertex_id_t vid_counter;
 		___size_t  num_pages;
-		std::shared_ptr<page_builder_t> page{ std::make_shared<page_builder_t>() };
+		bool       elide_zero_degree{ false };
+		pooled_ptr<page_builder_t, page_pool_t> page{ make_pooled<page_builder_t>(page_pool_t::instance()) };
 };
 
 #define RID_TABLE_GENERATOR_TEMPLATE template <typename PageTy, typename RIDTuplePayloadTy, template <typename _ElemTy,	typename > class RIDTupleContTy >
@@ -162,6 +247,7 @@ void RID_TABLE_GENERATOR::init()
 	next_svid = 0;
 	vid_counter = 0;
 	num_pages = 0;
+	page->reset();
 }
 
 RID_TABLE_GENERATOR_TEMPLATE
@@ -231,6 +317,101 @@ typename RID_TABLE_GENERATOR::generate_result RID_TABLE_GENERATOR::generate(edge
 	return this->generate(edge_iterator);
 }
 
+RID_TABLE_GENERATOR_TEMPLATE
+template <typename DegreeTy>
+typename RID_TABLE_GENERATOR::generate_result RID_TABLE_GENERATOR::generate(const DegreeTy* degrees, ___size_t num_vertices, vertex_id_t first_vid)
+{
+	rid_table_t table;
+	if (0 == num_vertices)
+		return generate_result{ generator_error_t::init_failed_empty_edgeset, table };
+
+	this->init();
+	next_svid = first_vid;
+	vid_counter = first_vid;
+	for (___size_t i = 0; i < num_vertices; ++i)
+		iteration_per_vertex(table, static_cast<___size_t>(degrees[i]));
+	flush(table);
+	return generate_result{ generator_error_t::success, table };
+}
+
+/* ---------------------------------------------------------------
+**
+** Parallel RID table generation
+** The packing is greedy, so the pages of a vertex range depend on
+** the page which is open when the range begins. But the state of
+** the generator at a vertex boundary is only "the open page starts
+** at vertex s": two runs whose open pages start at the same vertex
+** make the same decisions from there on (with zero-degree elision,
+** an elided vertex only extends the range of the open page).
+** 1) every worker packs its vertex range as if a page started at its
+**    first vertex (speculative tables)
+** 2) the boundaries are stitched in order: the exact generator of
+**    the previous ranges goes on into the next range until it opens
+**    a page at a vertex where the speculative run of the range also
+**    opened one; the rest of the speculative table is exact. An LP
+**    vertex (which closes its chain) always converges, and an SP
+**    range converges within a page or two.
+**
+** ------------------------------------------------------------ */
+
+RID_TABLE_GENERATOR_TEMPLATE
+template <typename DegreeTy>
+typename RID_TABLE_GENERATOR::generate_result RID_TABLE_GENERATOR::generate_parallel(const DegreeTy* degrees, ___size_t num_vertices, vertex_id_t first_vid, ___size_t num_threads)
+{
+	if (num_threads == 0)
+		num_threads = std::max<___size_t>(1, std::thread::hardware_concurrency());
+	if (num_threads == 1 || num_vertices < 2)
+		return generate(degrees, num_vertices, first_vid);
+
+	const ___size_t chunk = (num_vertices + num_threads - 1) / num_threads;
+	const ___size_t num_chunks = (num_vertices + chunk - 1) / chunk;
+	std::vector<rid_table_generator> generators(num_chunks);
+	std::vector<rid_table_t> tables(num_chunks);
+
+	// (1) Speculative tables
+	auto pack = [&](___size_t c) {
+		rid_table_generator& gen = generators[c];
+		const ___size_t begin = c * chunk, end = std::min(num_vertices, begin + chunk);
+		gen.elide_zero_degree = elide_zero_degree;
+		gen.init();
+		gen.next_svid = static_cast<vertex_id_t>(first_vid + begin);
+		gen.vid_counter = gen.next_svid;
+		for (___size_t i = begin; i < end; ++i)
+			gen.iteration_per_vertex(tables[c], static_cast<___size_t>(degrees[i]));
+	};
+	std::vector<std::thread> workers;
+	for (___size_t c = 1; c < num_chunks; ++c)
+		workers.emplace_back(pack, c);
+	pack(0);
+	for (auto& worker : workers)
+		worker.join();
+
+	// (2) Stitch
+	rid_table_t table = std::move(tables[0]);
+	rid_table_generator* exact = &generators[0];
+	for (___size_t c = 1; c < num_chunks; ++c) {
+		const rid_table_t& speculative = tables[c];
+		const ___size_t end = std::min(num_vertices, (c + 1) * chunk);
+		for (___size_t i = c * chunk; i < end; ++i) {
+			const ___size_t size_before = table.size();
+			exact->iteration_per_vertex(table, static_cast<___size_t>(degrees[i]));
+			if (table.size() == size_before)
+				continue;
+			// A page was issued: did the speculative run open a page at the same vertex?
+			const vertex_id_t open = exact->next_svid;
+			auto it = std::lower_bound(speculative.begin(), speculative.end(), open,
+				[](const rid_tuple_t& tuple, vertex_id_t vid) { return tuple.start_vid < vid; });
+			if ((it != speculative.end() && it->start_vid == open) || generators[c].next_svid == open) {
+				table.insert(table.end(), it, speculative.end());
+				exact = &generators[c];
+				break;
+			}
+		}
+	}
+	exact->flush(table);
+	return generate_result{ generator_error_t::success, table };
+}
+
 RID_TABLE_GENERATOR_TEMPLATE
 void RID_TABLE_GENERATOR::iteration_per_vertex(rid_table_t& out_table, ___size_t num_edges)
 {
@@ -256,6 +437,9 @@ void RID_TABLE_GENERATOR::flush(rid_table_t& table)
 RID_TABLE_GENERATOR_TEMPLATE
 void RID_TABLE_GENERATOR::small_page_iteration(rid_table_t& table, ___size_t num_edges)
 {
+	if (elide_zero_degree && num_edges == 0 && !page->is_empty())
+		return; // elided: in the range of the open page, without a slot
+
 	auto  scan_result = page->scan();
 	bool& slot_available = scan_result.first;
 	auto& capacity = scan_result.second;
@@ -274,7 +458,7 @@ void RID_TABLE_GENERATOR::large_page_iteration(rid_table_t& table, ___size_t num
 	if (!page->is_empty())
 		issue_sp(table);
 
-	___size_t required_ext_pages = static_cast<___size_t>(std::floor((num_edges - page_builder_t::MaximumEdgesInHeadPage) / page_builder_t::MaximumEdgesInExtPage)) + 1;
+	___size_t required_ext_pages = (num_edges - page_builder_t::MaximumEdgesInHeadPage + page_builder_t::MaximumEdgesInExtPage - 1) / page_builder_t::MaximumEdgesInExtPage;
 	issue_lp_head(table, required_ext_pages);
 	issue_lp_exts(table, required_ext_pages);
 }
@@ -287,7 +471,7 @@ void RID_TABLE_GENERATOR::issue_sp(rid_table_t& table)
 	tuple.auxiliary = 0; // small page: 0
 	table.push_back(tuple);
 	next_svid = vid_counter;
-	page->clear();
+	page->reset();
 	++num_pages;
 }
 
@@ -299,7 +483,7 @@ void RID_TABLE_GENERATOR::issue_lp_head(rid_table_t& table, ___size_t num_relate
 	tuple.auxiliary = static_cast<typename rid_tuple_t::auxiliary_t>(num_related); // head page: the number of related pages
 	table.push_back(tuple);
 	// This function does not update a member variable 'last_vid' 
-	page->clear();
+	page->reset();
 	++num_pages;
 }
 
@@ -313,14 +497,114 @@ void RID_TABLE_GENERATOR::issue_lp_exts(rid_table_t& table, ___size_t num_ext_pa
 		table.push_back(tuple);
 	}
 	next_svid = vid_counter + 1;
-	page->clear();
+	page->reset();
 	num_pages += num_ext_pages;
 }
 
 #undef RID_TABLE_GENERATOR
 #undef RID_TABLE_GENERATOR_TEMPLATE
 
-template <typename PageBuilderTy, typename RIDTableTy>
+/* ---------------------------------------------------------------
+**
+** PageDB generator checkpoint
+** A snapshot of the generator state at a vertex boundary. Pages
+** before 'num_pages' are synced through the page sink before the
+** checkpoint is written and the partially built page is carried in
+** the checkpoint itself. The checkpoint file is always synced to
+** the disk; the pages are only if the sink can: fd_page_sink calls
+** fsync, ostream_page_sink calls its sync hook, and without a hook
+** a std::ostream is only flushed (the pages then survive a crash of
+** the process, not of the machine). On resume, an output shorter
+** than 'num_pages' pages is refused instead of leaving a hole.
+** (edge|vertex)_input_offset are the positions of the input streams
+** reported by the user-supplied tell functions; on resume, the user
+** seeks the inputs to these positions before calling resume().
+**
+** ------------------------------------------------------------ */
+#pragma pack(push, 1)
+template <typename PageBuilderTy>
+struct pagedb_checkpoint
+{
+	using builder_t = PageBuilderTy;
+	using vertex_t = vertex_template<typename builder_t::vertex_id_t, typename builder_t::vertex_payload_t>;
+	static constexpr std::uint64_t Magic = 0x54504B4342444750ull; // "PGDBCKPT"
+	std::uint64_t magic;
+	std::uint64_t page_size;
+	std::uint64_t next_vid;
+	std::uint64_t max_vid;
+	std::uint64_t vid_counter;
+	std::uint64_t num_pages;
+	std::uint64_t edge_input_offset;
+	std::uint64_t vertex_input_offset;
+	std::uint8_t  pending_vertex_valid;
+	vertex_t      pending_vertex;
+	std::uint8_t  page[builder_t::PageSize];
+};
+#pragma pack(pop)
+
+// Writes a checkpoint to "<filepath>.tmp", syncs it and renames it over filepath,
+// so that a crash leaves either the previous or the new checkpoint behind, never a torn or a missing one.
+template <typename CheckpointTy>
+bool write_checkpoint(const CheckpointTy& checkpoint, const char* filepath)
+{
+	std::string tmp_path{ filepath };
+	tmp_path += ".tmp";
+	std::FILE* fp = std::fopen(tmp_path.c_str(), "wb");
+	if (!fp)
+		return false;
+	bool written = (1 == std::fwrite(&checkpoint, sizeof(CheckpointTy), 1, fp)) && (0 == std::fflush(fp));
+#if _WIN32 || _WIN64
+	written = written && (0 == _commit(_fileno(fp)));
+#else
+	written = written && (0 == ::fsync(fileno(fp)));
+#endif
+	written = (0 == std::fclose(fp)) && written;
+	if (!written)
+		return false;
+#if _WIN32 || _WIN64
+	// std::rename does not replace an existing file on Windows
+	return 0 != MoveFileExA(tmp_path.c_str(), filepath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+	// rename(2) replaces filepath atomically
+	return 0 == std::rename(tmp_path.c_str(), filepath);
+#endif
+}
+
+template <typename CheckpointTy>
+bool read_checkpoint(CheckpointTy& checkpoint, const char* filepath)
+{
+	std::ifstream ifs{ filepath, std::ios::in | std::ios::binary };
+	ifs.read(reinterpret_cast<char*>(&checkpoint), sizeof(CheckpointTy));
+	if (ifs.gcount() != sizeof(CheckpointTy))
+		return false;
+	return checkpoint.magic == CheckpointTy::Magic && checkpoint.page_size == CheckpointTy::builder_t::PageSize;
+}
+
+/* ---------------------------------------------------------------
+**
+** Generating a part of a PageDB
+** By default the generated vertices start at the source of the first
+** edgeset and every edge is located in the RID table of the PageDB
+** being generated. A producer of a PageDB slice (pagedb_partitioner)
+** keeps the packing of the generator and overrides only these:
+** - set_vertex_range(first_vid, num_vertices): the vertices are
+**   exactly [first_vid, first_vid + num_vertices), as those of
+**   rid_table_generator::generate(degrees, num_vertices, first_vid);
+**   an empty edge input is not an error then
+** - set_edge_translator(translator): the adjacency element of an
+**   edge is made by the translator, e.g. in another page space
+**
+** Page output
+** The pages go through a buffered_page_writer over the sink SinkTy
+** (see page_writer.h). The std::ostream overloads make a writer of
+** pages_per_flush pages over the stream (ostream_page_sink only);
+** the page_writer_t overloads write to the caller's writer, e.g.
+**   generator_traits<page_t>::pagedb_generator_for_sink_t<fd_page_sink> gen{ rid_table };
+**   decltype(gen)::page_writer_t writer{ pages_per_flush, "graph.pages", true }; // O_DIRECT
+**   gen.generate(edge_iterator, writer);
+**
+** ------------------------------------------------------------ */
+template <typename PageBuilderTy, typename RIDTableTy, typename SinkTy = ostream_page_sink>
 class pagedb_generator
 {
 public:
@@ -331,172 +615,402 @@ public:
 	using rid_tuple_t = typename rid_table_t::value_type;
 	using edge_t = edge_template<vertex_id_t, edge_payload_t>;
 	using vertex_t = vertex_template<vertex_id_t, vertex_payload_t>;
+	using sink_t = SinkTy;
+	using page_writer_t = buffered_page_writer<PageSize, sink_t>;
+	using checkpoint_t = pagedb_checkpoint<builder_t>;
+	using vertex_index_t = vertex_index<vertex_id_t, page_id_t, slot_offset_t>;
+	using page_pool_t = page_pool<PageSize>;
 
-	pagedb_generator(rid_table_t& rid_table_);
+	pagedb_generator(rid_table_t& rid_table_, ___size_t pages_per_flush_ = page_writer_t::DefaultPagesPerFlush);
 
 	using edgeset_t = std::vector<edge_t>;
 	using edge_iteration_result_t = std::pair<edgeset_t /* sorted vertex #'s edgeset */, vertex_id_t /* max_vid */>;
 	using edge_iterator_t = std::function< edge_iteration_result_t() >;
 	using vertex_iteration_result_t = std::pair<bool /* success or failure */, vertex_t /* vertex */>;
 	using vertex_iterator_t = std::function< vertex_iteration_result_t() >;
+	using input_tell_t = std::function< std::uint64_t() >;
+	using edge_translator_t = std::function< void(const edge_t& /* edge */, adj_list_elem_t* /* out */) >;
 
 	// Enabled if vertex_payload_t is void type.
 	template <typename PayloadTy = vertex_payload_t>
 	typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type generate(edge_iterator_t edge_iterator, std::ostream& os);
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type generate(edge_iterator_t edge_iterator, page_writer_t& out);
 	// Enabled if vertex_payload_t is non-void type.
 	template <typename PayloadTy = vertex_payload_t>
 	typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type generate(edge_iterator_t edge_iterator, vertex_iterator_t vertex_iterator, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os);
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type generate(edge_iterator_t edge_iterator, vertex_iterator_t vertex_iterator, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, page_writer_t& out);
 
+	// OutputTy: std::ostream or page_writer_t
 	// Enabled if vertex_payload_t is void type.
+	template <typename PayloadTy = vertex_payload_t, typename OutputTy = std::ostream>
+	typename std::enable_if<std::is_void<PayloadTy>::value>::type generate(edge_t* sorted_edges, ___size_t num_edges, OutputTy& os);
+	// Enabled if vertex_payload_t is non-void type.
+	template <typename PayloadTy = vertex_payload_t, typename OutputTy = std::ostream>
+	typename std::enable_if<!std::is_void<PayloadTy>::value>::type generate(edge_t* sorted_edges, ___size_t num_edges, vertex_t* sorted_vertices, ___size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, OutputTy& os);
+
+	/// Checkpoint: write a checkpoint to 'filepath' whenever 'interval_pages' pages have been issued since the last one.
+	// The tell functions report the current position of the edge (vertex) input, which is recorded in the checkpoint.
+	// The pages are synced through the sink first; a std::ostream reaches the disk only through a writer whose sink has a sync hook.
+	void enable_checkpoint(const char* filepath, ___size_t interval_pages, input_tell_t edge_input_tell, input_tell_t vertex_input_tell = nullptr);
+	void disable_checkpoint();
+
+	/// Vertex index: record the (page_id, slot_offset, is_lp) of every vertex while generating.
+	// If filepath is given, the index is written there when the generation finishes.
+	void enable_vertex_index(const char* filepath = nullptr);
+	void disable_vertex_index();
+	// The index recorded by the last generation (named apart from the vertex_index class template)
+	inline const vertex_index_t& vertex_locations() const
+	{
+		return vindex;
+	}
+
+	/// Zero-degree elision: zero-degree vertices of a small page do not own a slot (except the first vertex of a page);
+	// the RID table must come from a rid_table_generator with elision enabled. The payload of an elided vertex is not stored.
+	inline void enable_zero_degree_elision(bool enabled = true)
+	{
+		elide_zero_degree = enabled;
+	}
+
+	/// Vertex range: generate the vertices [first_vid, first_vid + num_vertices) whatever their degrees (0: from the first edgeset)
+	inline void set_vertex_range(vertex_id_t first_vid, ___size_t num_vertices)
+	{
+		range_first_vid = first_vid;
+		range_num_vertices = num_vertices;
+	}
+	/// Edge translator: makes the adjacency element of an edge instead of the RID table lookup (nullptr: the lookup)
+	inline void set_edge_translator(edge_translator_t translator)
+	{
+		edge_translator = translator;
+	}
+
+	/// Resume: continue an interrupted generation from a checkpoint.
+	// The inputs must be positioned at checkpoint.(edge|vertex)_input_offset and the output must be
+	// the previous output opened without truncation (e.g. std::ios::in | std::ios::out | std::ios::binary);
+	// a given writer must not have been written to. An output shorter than the checkpoint fails the resume.
+	// Enabled if vertex_payload_t is void type.
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type resume(const checkpoint_t& checkpoint, edge_iterator_t edge_iterator, std::ostream& os);
 	template <typename PayloadTy = vertex_payload_t>
-	typename std::enable_if<std::is_void<PayloadTy>::value>::type generate(edge_t* sorted_edges, ___size_t num_edges, std::ostream& os);
+	typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type resume(const checkpoint_t& checkpoint, edge_iterator_t edge_iterator, page_writer_t& out);
 	// Enabled if vertex_payload_t is non-void type.
 	template <typename PayloadTy = vertex_payload_t>
-	typename std::enable_if<!std::is_void<PayloadTy>::value>::type generate(edge_t* sorted_edges, ___size_t num_edges, vertex_t* sorted_vertices, ___size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os);
+	typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type resume(const checkpoint_t& checkpoint, edge_iterator_t edge_iterator, vertex_iterator_t vertex_iterator, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os);
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type resume(const checkpoint_t& checkpoint, edge_iterator_t edge_iterator, vertex_iterator_t vertex_iterator, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, page_writer_t& out);
 
 protected:
-	void init();
-	void iteration_per_vertex(std::ostream& os, const vertex_t& vertex, edge_t* edges, ___size_t num_edges);
-	void flush(std::ostream& os);
-	void small_page_iteration(std::ostream& os, const vertex_t& vertex, edge_t* edges, ___size_t num_edges);
-	void large_page_iteration(std::ostream& os, const vertex_t& vertex, edge_t* edges, ___size_t num_edges);
-	void issue_page(std::ostream& os, page_flag_t flags);
+	void init(page_writer_t& out);
+	bool start(const edge_iteration_result_t& result);
+	bool restore(const checkpoint_t& checkpoint, page_writer_t& out);
+	template <typename VertexSourceTy>
+	generator_error_t iterate(edge_iterator_t& edge_iterator, edge_iteration_result_t& result, VertexSourceTy vertex_source);
+	vertex_t next_weighted_vertex(vertex_id_t vid, vertex_iterator_t& vertex_iterator, const vertex_t& default_vertex);
+	bool checkpoint_if_needed();
+	void iteration_per_vertex(const vertex_t& vertex, edge_t* edges, ___size_t num_edges);
+	generator_error_t flush();
+	void small_page_iteration(const vertex_t& vertex, edge_t* edges, ___size_t num_edges);
+	void large_page_iteration(const vertex_t& vertex, edge_t* edges, ___size_t num_edges);
+	void issue_page(page_flag_t flags);
 	void update_list_buffer(edge_t* edges, ___size_t num_edges);
+	inline void record_vertex(vertex_id_t vid, slot_offset_t slot_offset, bool is_lp)
+	{
+		if (vertex_index_enabled)
+			vindex.append(vid, static_cast<page_id_t>(num_pages), slot_offset, is_lp);
+	}
 
 	rid_table_t& rid_table;
+	vertex_id_t next_vid;
+	vertex_id_t max_vid;
 	___size_t  vid_counter;
 	___size_t  num_pages;
-	std::vector<adj_list_elem_t> list_buffer;
-	std::shared_ptr<builder_t> page{ std::make_shared<builder_t>() };
+	___size_t  pages_per_flush;
+	vertex_iteration_result_t pending_vertex; // look-ahead of the vertex iterator
+	// A list never spans more than a page, so the buffer is a block of the page pool as well
+	struct list_buffer_t {
+		adj_list_elem_t elems[MaximumEdgesInExtPage];
+	};
+	pooled_ptr<list_buffer_t, page_pool_t> list_buffer{ make_pooled<list_buffer_t>(page_pool_t::instance()) };
+	pooled_ptr<builder_t, page_pool_t> page{ make_pooled<builder_t>(page_pool_t::instance()) };
+	page_writer_t* writer{ nullptr }; // the output of the running generation
+
+	bool                  elide_zero_degree{ false };
+
+	vertex_id_t       range_first_vid{ 0 };
+	___size_t         range_num_vertices{ 0 };
+	edge_translator_t edge_translator;
+
+	std::string  checkpoint_path;
+	___size_t    checkpoint_interval{ 0 };
+	___size_t    checkpoint_last_pages{ 0 };
+	input_tell_t edge_input_tell;
+	input_tell_t vertex_input_tell;
+
+	bool           vertex_index_enabled{ false };
+	std::string    vertex_index_path;
+	vertex_index_t vindex;
 };
 
-#define PAGEDB_GENERATOR_TEMPALTE template <typename PageBuilderTy, typename RIDTableTy>
-#define PAGEDB_GENERATOR pagedb_generator<PageBuilderTy, RIDTableTy>
+#define PAGEDB_GENERATOR_TEMPALTE template <typename PageBuilderTy, typename RIDTableTy, typename SinkTy>
+#define PAGEDB_GENERATOR pagedb_generator<PageBuilderTy, RIDTableTy, SinkTy>
 
 PAGEDB_GENERATOR_TEMPALTE
-PAGEDB_GENERATOR::pagedb_generator(rid_table_t& rid_table_) :
-	rid_table{ rid_table_ }
+PAGEDB_GENERATOR::pagedb_generator(rid_table_t& rid_table_, ___size_t pages_per_flush_) :
+	rid_table{ rid_table_ },
+	pages_per_flush{ pages_per_flush_ }
 {
 
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-void PAGEDB_GENERATOR::init()
+void PAGEDB_GENERATOR::init(page_writer_t& out)
 {
 	vid_counter = 0;
 	num_pages = 0;
+	checkpoint_last_pages = 0;
+	pending_vertex = vertex_iteration_result_t{ false, vertex_t{} };
+	page->reset();
+	page->flags() = 0;
+	writer = &out;
+	vindex.clear();
 }
 
+// Start: the first vertex and the last one known so far; false if there is nothing to generate
 PAGEDB_GENERATOR_TEMPALTE
-template <typename PayloadTy>
-typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(edge_iterator_t edge_iterator, std::ostream& os)
+bool PAGEDB_GENERATOR::start(const edge_iteration_result_t& result)
 {
-	vertex_id_t vid;
-	vertex_id_t max_vid;
-
-	// Init phase
-	this->init();
-	edge_iteration_result_t result = edge_iterator();
+	if (0 != range_num_vertices) {
+		next_vid = range_first_vid;
+		max_vid = static_cast<vertex_id_t>(range_first_vid + range_num_vertices - 1);
+		return true;
+	}
 	if (0 == result.first.size())
-		return generator_error_t::init_failed_empty_edgeset; // initialize failed;
-	vid = result.first[0].src;
+		return false;
+	next_vid = result.first[0].src;
 	max_vid = result.second;
+	return true;
+}
 
-	// Iteration
-	do
-	{
-		iteration_per_vertex(os, vertex_t{ vid }, result.first.data(), result.first.size());
-		vid += 1;
+PAGEDB_GENERATOR_TEMPALTE
+bool PAGEDB_GENERATOR::restore(const checkpoint_t& checkpoint, page_writer_t& out)
+{
+	if (checkpoint.magic != checkpoint_t::Magic || checkpoint.page_size != PageSize || checkpoint.num_pages > rid_table.size())
+		return false;
+	if (0 != out.number_of_pages())
+		return false;
+	// The pages the checkpoint refers to must all be in the output
+	std::uint64_t output_bytes = 0;
+	if (!out.sink().size(output_bytes) || output_bytes < static_cast<std::uint64_t>(checkpoint.num_pages) * PageSize)
+		return false;
+	next_vid = static_cast<vertex_id_t>(checkpoint.next_vid);
+	max_vid = static_cast<vertex_id_t>(checkpoint.max_vid);
+	vid_counter = static_cast<___size_t>(checkpoint.vid_counter);
+	num_pages = static_cast<___size_t>(checkpoint.num_pages);
+	checkpoint_last_pages = num_pages;
+	pending_vertex = vertex_iteration_result_t{ 0 != checkpoint.pending_vertex_valid, checkpoint.pending_vertex };
+	memcpy(static_cast<void*>(page.get()), checkpoint.page, PageSize);
+	// Locations of the vertices placed before the checkpoint
+	if (vertex_index_enabled)
+		vindex.build(rid_table, vid_counter);
+
+	// Discard pages issued after the checkpoint; they will be regenerated identically.
+	if (!out.sink().seek(static_cast<std::uint64_t>(num_pages) * PageSize))
+		return false;
+	writer = &out;
+	return true;
+}
 
-		result = edge_iterator();
-		if (0 == result.first.size())
-			break; // parsing error?
+PAGEDB_GENERATOR_TEMPALTE
+void PAGEDB_GENERATOR::enable_checkpoint(const char* filepath, ___size_t interval_pages, input_tell_t edge_input_tell_, input_tell_t vertex_input_tell_)
+{
+	checkpoint_path = filepath;
+	checkpoint_interval = interval_pages;
+	edge_input_tell = edge_input_tell_;
+	vertex_input_tell = vertex_input_tell_;
+}
 
-		if (result.first[0].src > vid)
-		{
-			for (vertex_id_t id = vid; id < result.first[0].src; ++id)
-				iteration_per_vertex(os, vertex_t{ id }, result.first.data(), 0);
-			vid = result.first[0].src;
-		}
+PAGEDB_GENERATOR_TEMPALTE
+void PAGEDB_GENERATOR::disable_checkpoint()
+{
+	checkpoint_interval = 0;
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+void PAGEDB_GENERATOR::enable_vertex_index(const char* filepath)
+{
+	vertex_index_enabled = true;
+	vertex_index_path = (filepath) ? filepath : "";
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+void PAGEDB_GENERATOR::disable_vertex_index()
+{
+	vertex_index_enabled = false;
+	vertex_index_path.clear();
+	vindex.clear();
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+bool PAGEDB_GENERATOR::checkpoint_if_needed()
+{
+	if (0 == checkpoint_interval || (num_pages - checkpoint_last_pages) < checkpoint_interval)
+		return true;
+
+	// Pages must be on the disk before the checkpoint which refers to them
+	if (!writer->sync())
+		return false;
+
+	checkpoint_t checkpoint;
+	memset(&checkpoint, 0, sizeof(checkpoint_t));
+	checkpoint.magic = checkpoint_t::Magic;
+	checkpoint.page_size = PageSize;
+	checkpoint.next_vid = next_vid;
+	checkpoint.max_vid = max_vid;
+	checkpoint.vid_counter = vid_counter;
+	checkpoint.num_pages = num_pages;
+	checkpoint.edge_input_offset = (edge_input_tell) ? edge_input_tell() : 0;
+	checkpoint.vertex_input_offset = (vertex_input_tell) ? vertex_input_tell() : 0;
+	checkpoint.pending_vertex_valid = pending_vertex.first ? 1 : 0;
+	checkpoint.pending_vertex = pending_vertex.second;
+	memcpy(checkpoint.page, page.get(), PageSize);
+	if (!write_checkpoint(checkpoint, checkpoint_path.c_str()))
+		return false;
+	checkpoint_last_pages = num_pages;
+	return true;
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename VertexSourceTy>
+generator_error_t PAGEDB_GENERATOR::iterate(edge_iterator_t& edge_iterator, edge_iteration_result_t& result, VertexSourceTy vertex_source)
+{
+	while (0 != result.first.size())
+	{
+		// Vertices without outgoing edges between the previous edgeset and this one
+		for (; next_vid < result.first[0].src; ++next_vid)
+			iteration_per_vertex(vertex_source(next_vid), nullptr, 0);
 
 		if (result.second > max_vid)
 			max_vid = result.second;
-	} while (true);
 
-	while (max_vid >= vid)
-		iteration_per_vertex(os, vertex_t{ vid++ }, nullptr, 0);
+		iteration_per_vertex(vertex_source(next_vid), result.first.data(), result.first.size());
+		next_vid += 1;
+
+		if (!checkpoint_if_needed())
+			return generator_error_t::checkpoint_failed;
 
-	flush(os);
-	return generator_error_t::success;
+		result = edge_iterator();
+	}
+
+	while (max_vid >= next_vid)
+	{
+		iteration_per_vertex(vertex_source(next_vid), nullptr, 0);
+		next_vid += 1;
+	}
+
+	return flush();
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+typename PAGEDB_GENERATOR::vertex_t PAGEDB_GENERATOR::next_weighted_vertex(vertex_id_t vid, vertex_iterator_t& vertex_iterator, const vertex_t& default_vertex)
+{
+	if (!pending_vertex.first || pending_vertex.second.vertex_id != vid)
+	{
+		vertex_t vertex = default_vertex;
+		vertex.vertex_id = vid;
+		return vertex;
+	}
+	vertex_t vertex = pending_vertex.second;
+	pending_vertex = vertex_iterator();
+	return vertex;
 }
 
 PAGEDB_GENERATOR_TEMPALTE
 template <typename PayloadTy>
-typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(edge_iterator_t edge_iterator, vertex_iterator_t vertex_iterator, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os)
+typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(edge_iterator_t edge_iterator, std::ostream& os)
 {
-	vertex_id_t vid;
-	vertex_id_t max_vid;
+	page_writer_t out{ pages_per_flush, os };
+	return this->generate(edge_iterator, out);
+}
 
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(edge_iterator_t edge_iterator, page_writer_t& out)
+{
 	// Init phase
-	this->init();
-	edge_iteration_result_t edge_iter_result = edge_iterator();
-	vertex_iteration_result_t vertex_iter_result = vertex_iterator();
-	if (0 == edge_iter_result.first.size())
+	this->init(out);
+	edge_iteration_result_t result = edge_iterator();
+	if (!start(result))
 		return generator_error_t::init_failed_empty_edgeset; // initialize failed;
-	bool& wv_enabled = vertex_iter_result.first;
-	vertex_t& wv = vertex_iter_result.second;
-	vid = edge_iter_result.first[0].src;
-
-	max_vid = edge_iter_result.second;
 
 	// Iteration
-	do
-	{
-		if (!wv_enabled || wv.vertex_id != vid)
-		{
-			iteration_per_vertex(os, vertex_t{ vid, default_slot_payload }, edge_iter_result.first.data(), edge_iter_result.first.size());
-		}
-		else
-		{
-			iteration_per_vertex(os, wv, edge_iter_result.first.data(), edge_iter_result.first.size());
-			vertex_iter_result = vertex_iterator();
-		}
-		vid += 1;
+	return iterate(edge_iterator, result, [](vertex_id_t vid) { return vertex_t{ vid }; });
+}
 
-		edge_iter_result = edge_iterator();
-		if (0 == edge_iter_result.first.size())
-			break; // eof
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(edge_iterator_t edge_iterator, vertex_iterator_t vertex_iterator, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os)
+{
+	page_writer_t out{ pages_per_flush, os };
+	return this->generate(edge_iterator, vertex_iterator, default_slot_payload, out);
+}
 
-		if (edge_iter_result.first[0].src > vid)
-		{
-			for (vertex_id_t id = vid; id < edge_iter_result.first[0].src; ++id)
-				iteration_per_vertex(os, vertex_t{ id, default_slot_payload }, nullptr, 0);
-			vid = edge_iter_result.first[0].src;
-		}
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::generate(edge_iterator_t edge_iterator, vertex_iterator_t vertex_iterator, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, page_writer_t& out)
+{
+	// Init phase
+	this->init(out);
+	edge_iteration_result_t result = edge_iterator();
+	pending_vertex = vertex_iterator();
+	if (!start(result))
+		return generator_error_t::init_failed_empty_edgeset; // initialize failed;
 
-		if (edge_iter_result.second > max_vid)
-			max_vid = edge_iter_result.second;
-	} while (true);
+	// Iteration
+	const vertex_t default_vertex{ 0, default_slot_payload };
+	return iterate(edge_iterator, result, [&](vertex_id_t vid) { return this->next_weighted_vertex(vid, vertex_iterator, default_vertex); });
+}
 
-	while (max_vid >= vid)
-	{
-		if (!wv_enabled || wv.vertex_id != vid)
-			iteration_per_vertex(os, vertex_t{ vid, default_slot_payload }, nullptr, 0);
-		else
-		{
-			iteration_per_vertex(os, wv, nullptr, 0);
-			vertex_iter_result = vertex_iterator();
-		}
-		vid += 1;
-	}
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::resume(const checkpoint_t& checkpoint, edge_iterator_t edge_iterator, std::ostream& os)
+{
+	page_writer_t out{ pages_per_flush, os };
+	return this->resume(checkpoint, edge_iterator, out);
+}
 
-	flush(os);
-	return generator_error_t::success;
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::resume(const checkpoint_t& checkpoint, edge_iterator_t edge_iterator, page_writer_t& out)
+{
+	if (!this->restore(checkpoint, out))
+		return generator_error_t::resume_failed_invalid_checkpoint;
+	edge_iteration_result_t result = edge_iterator();
+	return iterate(edge_iterator, result, [](vertex_id_t vid) { return vertex_t{ vid }; });
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::resume(const checkpoint_t& checkpoint, edge_iterator_t edge_iterator, vertex_iterator_t vertex_iterator, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os)
+{
+	page_writer_t out{ pages_per_flush, os };
+	return this->resume(checkpoint, edge_iterator, vertex_iterator, default_slot_payload, out);
 }
 
 PAGEDB_GENERATOR_TEMPALTE
 template <typename PayloadTy>
-typename std::enable_if<std::is_void<PayloadTy>::value>::type PAGEDB_GENERATOR::generate(edge_t* sorted_edges, ___size_t num_total_edges, std::ostream& os)
+typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_GENERATOR::resume(const checkpoint_t& checkpoint, edge_iterator_t edge_iterator, vertex_iterator_t vertex_iterator, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, page_writer_t& out)
+{
+	if (!this->restore(checkpoint, out))
+		return generator_error_t::resume_failed_invalid_checkpoint;
+	edge_iteration_result_t result = edge_iterator();
+	const vertex_t default_vertex{ 0, default_slot_payload };
+	return iterate(edge_iterator, result, [&](vertex_id_t vid) { return this->next_weighted_vertex(vid, vertex_iterator, default_vertex); });
+}
+
+PAGEDB_GENERATOR_TEMPALTE
+template <typename PayloadTy, typename OutputTy>
+typename std::enable_if<std::is_void<PayloadTy>::value>::type PAGEDB_GENERATOR::generate(edge_t* sorted_edges, ___size_t num_total_edges, OutputTy& os)
 {
 	___size_t off = 0;
 	vertex_id_t src;
@@ -527,8 +1041,8 @@ typename std::enable_if<std::is_void<PayloadTy>::value>::type PAGEDB_GENERATOR::
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-template <typename PayloadTy>
-typename std::enable_if<!std::is_void<PayloadTy>::value>::type PAGEDB_GENERATOR::generate(edge_t* sorted_edges, ___size_t num_total_edges, vertex_t* sorted_vertices, ___size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, std::ostream& os)
+template <typename PayloadTy, typename OutputTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value>::type PAGEDB_GENERATOR::generate(edge_t* sorted_edges, ___size_t num_total_edges, vertex_t* sorted_vertices, ___size_t num_vertices, typename std::enable_if< !std::is_void<PayloadTy>::value, PayloadTy >::type default_slot_payload, OutputTy& os)
 {
 	___size_t e_off = 0;
 	vertex_id_t src;
@@ -567,33 +1081,46 @@ typename std::enable_if<!std::is_void<PayloadTy>::value>::type PAGEDB_GENERATOR:
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-void PAGEDB_GENERATOR::iteration_per_vertex(std::ostream& os, const vertex_t& vertex, edge_t* edges, ___size_t num_edges)
+void PAGEDB_GENERATOR::iteration_per_vertex(const vertex_t& vertex, edge_t* edges, ___size_t num_edges)
 {
 	if (num_edges > builder_t::MaximumEdgesInHeadPage)
-		this->large_page_iteration(os, vertex, edges, num_edges);
+		this->large_page_iteration(vertex, edges, num_edges);
 	else
-		this->small_page_iteration(os, vertex, edges, num_edges);
+		this->small_page_iteration(vertex, edges, num_edges);
 	++vid_counter;
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-void PAGEDB_GENERATOR::flush(std::ostream& os)
+generator_error_t PAGEDB_GENERATOR::flush()
 {
 	if (!page->is_empty())
-		issue_page(os, slotted_page_flag::SP);
+		issue_page(slotted_page_flag::SP);
+	bool succeeded = writer->flush();
+	writer = nullptr;
+	if (succeeded && vertex_index_enabled && !vertex_index_path.empty())
+		succeeded = vindex.write(vertex_index_path.c_str());
+	return succeeded ? generator_error_t::success : generator_error_t::write_failed;
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-void PAGEDB_GENERATOR::small_page_iteration(std::ostream& os, const vertex_t& vertex, edge_t* edges, ___size_t num_edges)
+void PAGEDB_GENERATOR::small_page_iteration(const vertex_t& vertex, edge_t* edges, ___size_t num_edges)
 {
+	if (elide_zero_degree && num_edges == 0 && !page->is_empty()) {
+		// Elided: located at its offset in the range of the open page, which starts at the vertex of the first slot
+		record_vertex(vertex.vertex_id, static_cast<slot_offset_t>(vertex.vertex_id - page->slot(0).vertex_id), false);
+		page->flags() |= slotted_page_flag::ELIDED_VERTICES;
+		return;
+	}
+
 	auto scan_result = page->scan();
 	bool& slot_available = scan_result.first;
 	auto& capacity = scan_result.second;
 
 	if (!slot_available || (capacity < num_edges))
-		issue_page(os, slotted_page_flag::SP);
+		issue_page(slotted_page_flag::SP);
 
 	vertex.to_slot(*page);
+	record_vertex(vertex.vertex_id, static_cast<slot_offset_t>(vertex.vertex_id - page->slot(0).vertex_id), false);
 
 	if (num_edges == 0)
 		return;
@@ -601,60 +1128,60 @@ void PAGEDB_GENERATOR::small_page_iteration(std::ostream& os, const vertex_t& ve
 	auto offset = page->number_of_slots() - 1;
 	update_list_buffer(edges, num_edges);
 
-	page->add_list_sp(offset, list_buffer.data(), num_edges);
+	page->add_list_sp(offset, list_buffer->elems, num_edges);
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-void PAGEDB_GENERATOR::large_page_iteration(std::ostream& os, const vertex_t& vertex, edge_t* edges, ___size_t num_edges)
+void PAGEDB_GENERATOR::large_page_iteration(const vertex_t& vertex, edge_t* edges, ___size_t num_edges)
 {
 	if (!page->is_empty())
-		issue_page(os, slotted_page_flag::SP);
-
-	//___size_t required_ext_pages = static_cast<___size_t>(std::floor((num_edges - MaximumEdgesInHeadPage) / MaximumEdgesInExtPage)) + 1;
+		issue_page(slotted_page_flag::SP);
 
 	// Processing a head page
 	{
 		constexpr ___size_t num_edges_in_page = MaximumEdgesInHeadPage;
+		record_vertex(vertex.vertex_id, 0, true);
 		vertex.to_slot(*page);
 		update_list_buffer(edges, num_edges_in_page);
-		page->add_list_lp_head(num_edges, list_buffer.data(), num_edges_in_page);
-		issue_page(os, slotted_page_flag::LP_HEAD);
+		page->add_list_lp_head(num_edges, list_buffer->elems, num_edges_in_page);
+		issue_page(slotted_page_flag::LP_HEAD);
 	}
 
 	// Processing a extended pages
 	___size_t remained_edges = num_edges - MaximumEdgesInHeadPage;
 	___size_t offset = MaximumEdgesInHeadPage;
+	while (remained_edges > 0)
 	{
 		___size_t num_edges_per_page = (remained_edges >= MaximumEdgesInExtPage) ? MaximumEdgesInExtPage : remained_edges;
 		vertex.to_slot_ext(*page);
 		update_list_buffer(edges + offset, num_edges_per_page);
-		page->add_list_lp_ext(list_buffer.data(), num_edges_per_page);
+		page->add_list_lp_ext(list_buffer->elems, num_edges_per_page);
 		offset += num_edges_per_page;
 		remained_edges -= num_edges_per_page;
-		issue_page(os, slotted_page_flag::LP_EXTENDED);
+		issue_page(slotted_page_flag::LP_EXTENDED);
 	}
 }
 
 PAGEDB_GENERATOR_TEMPALTE
-void PAGEDB_GENERATOR::issue_page(std::ostream& os, page_flag_t flags)
+void PAGEDB_GENERATOR::issue_page(page_flag_t flags)
 {
-	page->flags() = flags;
-	builder_t* raw_ptr = page.get();
-	os.write(reinterpret_cast<char*>(raw_ptr), PageSize);
-	page->clear();
+	page->flags() = flags | (page->flags() & slotted_page_flag::ELIDED_VERTICES);
+	writer->write(page.get());
+	page->reset(); // zero-fills only the used regions; the next page overwrites nothing else
+	page->flags() = 0;
 	++num_pages;
 }
 
 PAGEDB_GENERATOR_TEMPALTE
 void PAGEDB_GENERATOR::update_list_buffer(edge_t* edges, ___size_t num_edges)
 {
-	list_buffer.clear();
-	adj_list_elem_t elem;
-	for (___size_t i = 0; i < num_edges; ++i)
-	{
-		edges[i].template to_adj_elem<builder_t>(rid_table, &elem);
-		list_buffer.push_back(elem);
+	if (edge_translator) {
+		for (___size_t i = 0; i < num_edges; ++i)
+			edge_translator(edges[i], &list_buffer->elems[i]);
+		return;
 	}
+	for (___size_t i = 0; i < num_edges; ++i)
+		edges[i].template to_adj_elem<builder_t>(rid_table, &list_buffer->elems[i]);
 }
 
 template <typename PageTy, typename RIDTuplePayloadTy = std::size_t, template <typename _ElemTy, typename = std::allocator<_ElemTy> > class RIDContainerTy = std::vector>
@@ -665,6 +1192,8 @@ struct generator_traits {
 	using rid_tuple_t = typename rid_table_generator_t::rid_tuple_t;
     using rid_table_t = typename rid_table_generator_t::rid_table_t;
 	using pagedb_generator_t = pagedb_generator<typename page_traits::page_builder_t, typename rid_table_generator_t::rid_table_t>;
+	template <typename SinkTy>
+	using pagedb_generator_for_sink_t = pagedb_generator<typename page_traits::page_builder_t, typename rid_table_generator_t::rid_table_t, SinkTy>;
 };
 
 template <typename RIDTableTy>
@@ -676,6 +1205,14 @@ void write_rid_table(RIDTableTy& rid_table, std::ostream& os)
 	}
 }
 
+template <typename PageContTy>
+void write_pages(PageContTy& pages, std::ostream& os)
+{
+	using page_t = typename PageContTy::value_type;
+	for (auto& page : pages)
+		os.write(reinterpret_cast<char*>(&page), page_t::PageSize);
+}
+
 template <typename PageTy>
 void print_page(PageTy& page, FILE* out_file = stdout)
 {
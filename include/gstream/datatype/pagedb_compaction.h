@@ -0,0 +1,361 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		pagedb_compaction.h
+*	@brief		Parallel compaction (repacking) of fragmented PageDBs
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGEDB_COMPACTION_H_
+#define _GSTREAM_DATATYPE_PAGEDB_COMPACTION_H_
+
+#include <gstream/datatype/pagedb.h>
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+/* ---------------------------------------------------------------
+**
+** Compaction
+** (1) Collect the location and the degree of each vertex from the
+**     base pages and the overflow store (parallel by page range).
+** (2) Build a new RID table from the degrees with the same packing
+**     rule as rid_table_generator, and derive the remap table
+**     old vertex -> new (page_id, slot_offset).
+** (3) Rebuild the pages with slotted_page_builder in parallel by new
+**     page range; every adjacency element is rewritten through the
+**     remap table. The overflow store is merged into the new pages.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+/// Fill factor: used bytes / data section bytes of the pages
+template <typename PageContTy>
+double fill_factor(PageContTy& pages)
+{
+	using page_t = typename PageContTy::value_type;
+	if (pages.size() == 0)
+		return 0.0;
+	double used = 0.0;
+	for (auto& page : pages)
+		used += static_cast<double>(page.footer.front + (page_t::DataSectionSize - page.footer.rear));
+	return used / (static_cast<double>(page_t::DataSectionSize) * static_cast<double>(pages.size()));
+}
+
+template <typename PageTy,
+	typename RIDTableTy = typename generator_traits<PageTy>::rid_table_t,
+	template <typename _ElemTy,
+	typename = std::allocator<_ElemTy> >
+	class PageContTy = std::vector >
+class pagedb_compactor {
+public:
+	using page_t = PageTy;
+	using traits_t = page_traits<page_t>;
+	using builder_t = typename traits_t::page_builder_t;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(builder_t);
+	ALIAS_SLOTTED_PAGE_TEMPLATE_CONSTDEFS(builder_t);
+	using rid_table_t = RIDTableTy;
+	using rid_tuple_t = typename rid_table_t::value_type;
+	using page_cont_t = PageContTy<page_t>;
+
+	struct vertex_location {
+		page_id_t     page_id;
+		slot_offset_t slot_offset;
+	};
+	// Indexed by (vertex_id - first_vertex_id())
+	using remap_table_t = std::vector<vertex_location>;
+
+	struct compaction_result {
+		generator_error_t error;
+		___size_t num_vertices;
+		___size_t num_old_pages;
+		___size_t num_overflow_pages;
+		___size_t num_new_pages;
+		double    old_fill_factor; // including the overflow store
+		double    new_fill_factor;
+	};
+
+	// num_threads = 0: std::thread::hardware_concurrency()
+	explicit pagedb_compactor(___size_t num_threads_ = 0);
+
+	/// Compact: repack (pages, overflow_pages, rid_table) densely into (out_pages, out_rid_table);
+	// init_failed_elided_pagedb if the PageDB was generated with zero-degree elision,
+	// failed_field_overflow (and the outputs are untouched) if a merged degree does not fit in record_size_t
+	// or a new page id in page_id_t
+	compaction_result compact(page_cont_t& pages, page_cont_t& overflow_pages, const rid_table_t& rid_table, page_cont_t& out_pages, rid_table_t& out_rid_table);
+
+	/// Remap table of the last compaction
+	inline const remap_table_t& remap_table() const
+	{
+		return remap;
+	}
+	inline vertex_id_t first_vertex_id() const
+	{
+		return first_vid;
+	}
+
+protected:
+	struct vertex_info {
+		page_id_t     page_id;     // old location
+		slot_offset_t slot_offset;
+		___size_t     degree;
+	};
+	struct overflow_ref {
+		vertex_id_t vertex_id;
+		___size_t   page_index;
+		offset_t    slot;
+	};
+
+	template <typename FnTy>
+	void parallel_for(___size_t count, FnTy fn);
+	void collect(page_cont_t& pages, page_cont_t& overflow_pages, const rid_table_t& rid_table, ___size_t num_vertices);
+	void build_remap(const rid_table_t& new_rid_table, vertex_id_t last_vid);
+	void gather(page_cont_t& pages, page_cont_t& overflow_pages, const rid_table_t& rid_table, vertex_id_t vid, std::vector<adj_list_elem_t>& out) const;
+	void rebuild(builder_t& builder, std::vector<adj_list_elem_t>& buffer, page_cont_t& pages, page_cont_t& overflow_pages, const rid_table_t& rid_table,
+		const rid_table_t& new_rid_table, page_cont_t& out_pages, ___size_t new_pid, vertex_id_t last_vid);
+
+	___size_t                 num_threads;
+	vertex_id_t               first_vid;
+	std::vector<vertex_info>  vertices;
+	std::vector<overflow_ref> overflow_refs; // sorted by vertex_id
+	remap_table_t             remap;
+};
+
+#define PAGEDB_COMPACTOR_TEMPLATE template <typename PageTy, typename RIDTableTy, template <typename _ElemTy, typename > class PageContTy>
+#define PAGEDB_COMPACTOR pagedb_compactor<PageTy, RIDTableTy, PageContTy>
+
+PAGEDB_COMPACTOR_TEMPLATE
+PAGEDB_COMPACTOR::pagedb_compactor(___size_t num_threads_) :
+	num_threads{ (num_threads_ > 0) ? num_threads_ : std::max<___size_t>(1, std::thread::hardware_concurrency()) },
+	first_vid{ 0 }
+{
+}
+
+PAGEDB_COMPACTOR_TEMPLATE
+template <typename FnTy>
+void PAGEDB_COMPACTOR::parallel_for(___size_t count, FnTy fn)
+{
+	const ___size_t num_workers = std::min(num_threads, std::max<___size_t>(1, count));
+	const ___size_t chunk = (count + num_workers - 1) / num_workers;
+	std::vector<std::thread> workers;
+	for (___size_t w = 1; w < num_workers; ++w)
+		workers.emplace_back(fn, std::min(count, w * chunk), std::min(count, (w + 1) * chunk));
+	fn(0, std::min(count, chunk));
+	for (auto& worker : workers)
+		worker.join();
+}
+
+PAGEDB_COMPACTOR_TEMPLATE
+typename PAGEDB_COMPACTOR::compaction_result PAGEDB_COMPACTOR::compact(page_cont_t& pages, page_cont_t& overflow_pages, const rid_table_t& rid_table, page_cont_t& out_pages, rid_table_t& out_rid_table)
+{
+	compaction_result result{ generator_error_t::success, 0, pages.size(), overflow_pages.size(), 0, 0.0, 0.0 };
+	if (pages.size() == 0 || rid_table.size() != pages.size()) {
+		result.error = generator_error_t::init_failed_empty_pagedb;
+		return result;
+	}
+	if (has_elided_vertices(pages, rid_table)) {
+		result.error = generator_error_t::init_failed_elided_pagedb; // vertices are collected from their slots
+		return result;
+	}
+
+	// (1) Vertex locations and degrees
+	first_vid = rid_table.front().start_vid;
+	const page_t& last_page = pages[pages.size() - 1];
+	const vertex_id_t last_vid = last_page.is_lp() ? rid_table.back().start_vid : static_cast<vertex_id_t>(rid_table.back().start_vid + last_page.number_of_slots() - 1);
+	result.num_vertices = static_cast<___size_t>(last_vid - first_vid) + 1;
+	collect(pages, overflow_pages, rid_table, result.num_vertices);
+
+	// (2) New RID table and remap table; the merged degree of a large vertex is stored in a record_size_t
+	std::vector<___size_t> degrees(result.num_vertices);
+	for (___size_t i = 0; i < result.num_vertices; ++i) {
+		degrees[i] = vertices[i].degree;
+		if (degrees[i] > static_cast<___size_t>(std::numeric_limits<record_size_t>::max())) {
+			result.error = generator_error_t::failed_field_overflow;
+			return result;
+		}
+	}
+	using rid_generator_t = rid_table_generator<page_t, typename rid_tuple_t::auxiliary_t>;
+	rid_generator_t rid_generator;
+	auto generate_result = rid_generator.generate(degrees.data(), result.num_vertices, first_vid);
+	if (generate_result.table.size() - 1 > static_cast<___size_t>(std::numeric_limits<page_id_t>::max())) {
+		result.error = generator_error_t::failed_field_overflow;
+		return result;
+	}
+	out_rid_table.clear();
+	out_rid_table.insert(out_rid_table.end(), generate_result.table.begin(), generate_result.table.end());
+	build_remap(out_rid_table, last_vid);
+
+	// (3) Rebuild pages in parallel by new page range
+	out_pages.clear();
+	out_pages.resize(out_rid_table.size());
+	parallel_for(out_rid_table.size(), [&](___size_t begin, ___size_t end) {
+		std::unique_ptr<builder_t> builder{ new builder_t() };
+		std::vector<adj_list_elem_t> buffer;
+		for (___size_t new_pid = begin; new_pid < end; ++new_pid)
+			this->rebuild(*builder, buffer, pages, overflow_pages, rid_table, out_rid_table, out_pages, new_pid, last_vid);
+	});
+
+	result.num_new_pages = out_pages.size();
+	result.old_fill_factor = (fill_factor(pages) * pages.size() + fill_factor(overflow_pages) * overflow_pages.size()) / (pages.size() + overflow_pages.size());
+	result.new_fill_factor = fill_factor(out_pages);
+	return result;
+}
+
+PAGEDB_COMPACTOR_TEMPLATE
+void PAGEDB_COMPACTOR::collect(page_cont_t& pages, page_cont_t& overflow_pages, const rid_table_t& rid_table, ___size_t num_vertices)
+{
+	vertices.assign(num_vertices, vertex_info{ 0, 0, 0 });
+
+	parallel_for(pages.size(), [&](___size_t begin, ___size_t end) {
+		for (___size_t pid = begin; pid < end; ++pid) {
+			page_t& page = pages[pid];
+			const vertex_id_t start_vid = rid_table[pid].start_vid;
+			if (page.is_lp_head()) {
+				// Count the elements of the whole chain
+				___size_t degree = (page.footer.front - sizeof(record_size_t)) / sizeof(adj_list_elem_t);
+				for (___size_t ext = 1; ext <= static_cast<___size_t>(rid_table[pid].auxiliary); ++ext)
+					degree += pages[pid + ext].footer.front / sizeof(adj_list_elem_t);
+				vertices[start_vid - first_vid] = vertex_info{ static_cast<page_id_t>(pid), 0, degree };
+			}
+			else if (!page.is_lp_extended()) {
+				for (offset_t i = 0; i < page.number_of_slots(); ++i)
+					vertices[start_vid + i - first_vid] = vertex_info{ static_cast<page_id_t>(pid), static_cast<slot_offset_t>(i), static_cast<___size_t>(page.record_size(i)) };
+			}
+		}
+	});
+
+	// Spilled lists of the overflow store
+	overflow_refs.clear();
+	for (___size_t pid = 0; pid < pages.size(); ++pid) {
+		for (uint32_t link = pages[pid].overflow_link(); link != 0; link = overflow_pages[link - 1].overflow_link()) {
+			page_t& page = overflow_pages[link - 1];
+			for (offset_t i = 0; i < page.number_of_slots(); ++i) {
+				overflow_refs.push_back(overflow_ref{ page.slot(i).vertex_id, static_cast<___size_t>(link - 1), i });
+				vertices[page.slot(i).vertex_id - first_vid].degree += page.record_size(i);
+			}
+		}
+	}
+	std::stable_sort(overflow_refs.begin(), overflow_refs.end(), [](const overflow_ref& lhs, const overflow_ref& rhs) { return lhs.vertex_id < rhs.vertex_id; });
+}
+
+PAGEDB_COMPACTOR_TEMPLATE
+void PAGEDB_COMPACTOR::build_remap(const rid_table_t& new_rid_table, vertex_id_t last_vid)
+{
+	remap.resize(static_cast<___size_t>(last_vid - first_vid) + 1);
+	for (___size_t pid = 0; pid < new_rid_table.size(); ++pid) {
+		const rid_tuple_t& tuple = new_rid_table[pid];
+		if (tuple.auxiliary != 0) {
+			// large page: the head holds the vertex, extended pages are skipped
+			if (pid == 0 || new_rid_table[pid - 1].start_vid != tuple.start_vid)
+				remap[tuple.start_vid - first_vid] = vertex_location{ static_cast<page_id_t>(pid), 0 };
+			continue;
+		}
+		const vertex_id_t end_vid = (pid + 1 < new_rid_table.size()) ? new_rid_table[pid + 1].start_vid : static_cast<vertex_id_t>(last_vid + 1);
+		for (vertex_id_t vid = tuple.start_vid; vid != end_vid; ++vid)
+			remap[vid - first_vid] = vertex_location{ static_cast<page_id_t>(pid), static_cast<slot_offset_t>(vid - tuple.start_vid) };
+	}
+}
+
+PAGEDB_COMPACTOR_TEMPLATE
+void PAGEDB_COMPACTOR::gather(page_cont_t& pages, page_cont_t& overflow_pages, const rid_table_t& rid_table, vertex_id_t vid, std::vector<adj_list_elem_t>& out) const
+{
+	out.clear();
+	const vertex_info& info = vertices[vid - first_vid];
+	page_t& page = pages[info.page_id];
+	if (page.is_lp_head()) {
+		adj_list_elem_t* list = page.list(0);
+		out.insert(out.end(), list, list + (page.footer.front - sizeof(record_size_t)) / sizeof(adj_list_elem_t));
+		for (___size_t ext = 1; ext <= static_cast<___size_t>(rid_table[info.page_id].auxiliary); ++ext) {
+			page_t& ext_page = pages[info.page_id + ext];
+			list = ext_page.list_ext(0);
+			out.insert(out.end(), list, list + ext_page.footer.front / sizeof(adj_list_elem_t));
+		}
+	}
+	else {
+		adj_list_elem_t* list = page.list(info.slot_offset);
+		out.insert(out.end(), list, list + page.record_size(info.slot_offset));
+	}
+
+	auto range = std::equal_range(overflow_refs.begin(), overflow_refs.end(), overflow_ref{ vid, 0, 0 },
+		[](const overflow_ref& lhs, const overflow_ref& rhs) { return lhs.vertex_id < rhs.vertex_id; });
+	for (auto it = range.first; it != range.second; ++it) {
+		page_t& overflow_page = overflow_pages[it->page_index];
+		adj_list_elem_t* list = overflow_page.list(it->slot);
+		out.insert(out.end(), list, list + overflow_page.record_size(it->slot));
+	}
+
+	// Rewrite the pointers: old (page, slot) -> vertex_id -> new (page, slot)
+	for (auto& elem : out) {
+		const vertex_location& location = remap[rid_table[elem.page_id].start_vid + elem.slot_offset - first_vid];
+		elem.page_id = location.page_id;
+		elem.slot_offset = location.slot_offset;
+	}
+}
+
+PAGEDB_COMPACTOR_TEMPLATE
+void PAGEDB_COMPACTOR::rebuild(builder_t& builder, std::vector<adj_list_elem_t>& buffer, page_cont_t& pages, page_cont_t& overflow_pages, const rid_table_t& rid_table,
+	const rid_table_t& new_rid_table, page_cont_t& out_pages, ___size_t new_pid, vertex_id_t last_vid)
+{
+	const rid_tuple_t& tuple = new_rid_table[new_pid];
+	const bool is_lp = (tuple.auxiliary != 0);
+	if (is_lp && new_pid > 0 && new_rid_table[new_pid - 1].start_vid == tuple.start_vid)
+		return; // extended pages are built together with their head page
+
+	if (!is_lp) {
+		const vertex_id_t end_vid = (new_pid + 1 < new_rid_table.size()) ? new_rid_table[new_pid + 1].start_vid : static_cast<vertex_id_t>(last_vid + 1);
+		builder.reset();
+		for (vertex_id_t vid = tuple.start_vid; vid != end_vid; ++vid) {
+			const vertex_info& info = vertices[vid - first_vid];
+			gather(pages, overflow_pages, rid_table, vid, buffer);
+			auto record_offset = builder.footer.front;
+			offset_t offset = builder.add_dummy_slot();
+			slot_t& slot = builder.slot(offset);
+			slot = pages[info.page_id].slot(info.slot_offset);
+			slot.record_offset = static_cast<record_offset_t>(record_offset);
+			builder.add_list_sp(offset, buffer.data(), buffer.size());
+		}
+		builder.flags() = slotted_page_flag::SP;
+		builder.footer.reserved = 0;
+		memcpy(static_cast<void*>(&out_pages[new_pid]), &builder, PageSize);
+		return;
+	}
+
+	// Large page: head and extended pages
+	const vertex_info& info = vertices[tuple.start_vid - first_vid];
+	const slot_t& old_slot = pages[info.page_id].slot(info.slot_offset); // an SP vertex which grew into an LP is not at slot 0
+	gather(pages, overflow_pages, rid_table, tuple.start_vid, buffer);
+
+	builder.reset();
+	builder.add_dummy_slot();
+	builder.slot(0) = old_slot;
+	builder.slot(0).record_offset = 0;
+	builder.add_list_lp_head(buffer.size(), buffer.data(), MaximumEdgesInHeadPage);
+	builder.flags() = slotted_page_flag::LP_HEAD;
+	builder.footer.reserved = 0;
+	memcpy(static_cast<void*>(&out_pages[new_pid]), &builder, PageSize);
+
+	___size_t offset = MaximumEdgesInHeadPage;
+	for (___size_t ext = 1; ext <= static_cast<___size_t>(tuple.auxiliary); ++ext) {
+		___size_t num_edges_in_page = buffer.size() - offset;
+		if (num_edges_in_page > MaximumEdgesInExtPage)
+			num_edges_in_page = MaximumEdgesInExtPage;
+		builder.reset();
+		builder.add_dummy_slot_ext();
+		builder.slot(0) = old_slot;
+		builder.slot(0).record_offset = 0;
+		builder.add_list_lp_ext(buffer.data() + offset, num_edges_in_page);
+		builder.flags() = slotted_page_flag::LP_EXTENDED;
+		builder.footer.reserved = 0;
+		memcpy(static_cast<void*>(&out_pages[new_pid + ext]), &builder, PageSize);
+		offset += num_edges_in_page;
+	}
+}
+
+#undef PAGEDB_COMPACTOR
+#undef PAGEDB_COMPACTOR_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGEDB_COMPACTION_H_
@@ -0,0 +1,601 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		pagedb_csr.h
+*	@brief		Parallel conversions between CSR (offset, target, payload) arrays and PageDB
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGEDB_CSR_H_
+#define _GSTREAM_DATATYPE_PAGEDB_CSR_H_
+
+#include <gstream/datatype/pagedb.h>
+#include <gstream/io/mapped_file.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+/* ---------------------------------------------------------------
+**
+** PageDB from CSR
+** A graph in CSR form already knows what pagedb_generator has to
+** discover edge by edge: the degree of every vertex is an offset
+** difference, and the neighbours of a vertex are a contiguous run
+** of the target array.
+** (1) RID table: rid_table_generator::generate_parallel() over the
+**     degrees
+** (2) Locations: the (page_id, slot_offset) of every vertex, filled
+**     page by page from the RID table (a vertex of a large page is
+**     located at its head page, as vid_to_pid() does)
+** (3) Pages: every worker builds a range of pages in place in the
+**     page container; a record is written by a single loop which
+**     translates the targets of the run through the location table
+**     and stores the elements into list() (list_ext()) of the page,
+**     with no edge_t and no intermediate list buffer.
+** The pages are those of pagedb_generator over the same vertex range
+** [first_vid, first_vid + num_vertices), byte for byte.
+**
+** Preconditions: offsets has num_vertices + 1 entries (offsets[0] is
+** the index of the first edge), every target lies in the vertex
+** range, and the targets of a vertex are in the order they should
+** appear in its list.
+**
+** CSR from PageDB (pagedb_csr_exporter)
+** Writes the offsets, targets and edge payloads of a PageDB (and of
+** its overflow store) into files which are created at their final
+** size and mapped (mapped_file::create), so that every worker
+** stores straight into the page cache:
+** (1) Degrees: every worker reads the record sizes of a range of
+**     pages (LP: the head) and of their overflow chains into
+**     offsets[v + 1] (0 for a vertex without a slot, zero-degree
+**     elision)
+** (2) Offsets: a two-pass prefix sum over the worker ranges
+** (3) Runs: every worker copies the lists of its vertices to
+**     targets[offsets[v]..], translating (page_id, slot_offset) back
+**     to start_vid + slot_offset; an LP chain is copied by the worker
+**     of its head, spilled lists follow the list of their owner
+** Raw little-endian arrays, no header: offsets[num_vertices + 1] of
+** OffsetTy, targets[num_edges] of vertex_id_t, payloads[num_edges]
+** of edge_payload_t (not written for a void payload).
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+namespace _pagedb_csr {
+
+// Translate-and-store of an adjacency list element
+template <typename ElemTy, typename PayloadTy>
+struct elem_store {
+	static inline void store(ElemTy& out, const ElemTy& location, const PayloadTy* payloads, std::size_t edge)
+	{
+		out.page_id = location.page_id;
+		out.slot_offset = location.slot_offset;
+		out.payload = payloads[edge];
+	}
+};
+
+template <typename ElemTy>
+struct elem_store<ElemTy, void> {
+	static inline void store(ElemTy& out, const ElemTy& location, const void*, std::size_t)
+	{
+		out = location;
+	}
+};
+
+// Slot of a vertex: the vertex payload array (or the default payload)
+template <typename VertexTy, typename PayloadTy>
+struct vertex_source {
+	const PayloadTy* payloads;
+	PayloadTy        default_payload;
+	inline VertexTy operator()(typename VertexTy::vertex_id_t vid, std::size_t index) const
+	{
+		return VertexTy{ vid, (payloads != nullptr) ? payloads[index] : default_payload };
+	}
+};
+
+template <typename VertexTy>
+struct vertex_source<VertexTy, void> {
+	inline VertexTy operator()(typename VertexTy::vertex_id_t vid, std::size_t) const
+	{
+		return VertexTy{ vid };
+	}
+};
+
+// Translate-and-load of a run of adjacency list elements into targets[at..] (and payloads[at..] if payloads is not null)
+template <typename ElemTy, typename PayloadTy>
+struct run_load {
+	template <typename RIDTableTy, typename VertexIdTy>
+	static inline void load(const ElemTy* elems, std::size_t count, const RIDTableTy& rid_table, VertexIdTy* targets, PayloadTy* payloads, std::size_t at)
+	{
+		targets += at;
+		for (std::size_t i = 0; i < count; ++i)
+			targets[i] = static_cast<VertexIdTy>(rid_table[elems[i].page_id].start_vid + elems[i].slot_offset);
+		if (payloads == nullptr)
+			return;
+		payloads += at;
+		for (std::size_t i = 0; i < count; ++i)
+			payloads[i] = elems[i].payload;
+	}
+};
+
+template <typename ElemTy>
+struct run_load<ElemTy, void> {
+	template <typename RIDTableTy, typename VertexIdTy, typename PayloadStoreTy>
+	static inline void load(const ElemTy* elems, std::size_t count, const RIDTableTy& rid_table, VertexIdTy* targets, PayloadStoreTy*, std::size_t at)
+	{
+		targets += at;
+		for (std::size_t i = 0; i < count; ++i)
+			targets[i] = static_cast<VertexIdTy>(rid_table[elems[i].page_id].start_vid + elems[i].slot_offset);
+	}
+};
+
+} // !namespace _pagedb_csr
+
+template <typename PageTy,
+	typename RIDTableGeneratorTy = typename generator_traits<PageTy>::rid_table_generator_t,
+	template <typename _ElemTy,
+	typename = std::allocator<_ElemTy> >
+	class PageContTy = std::vector >
+class pagedb_from_csr {
+public:
+	using page_t = PageTy;
+	using traits_t = page_traits<page_t>;
+	using builder_t = typename traits_t::page_builder_t;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(builder_t);
+	ALIAS_SLOTTED_PAGE_TEMPLATE_CONSTDEFS(builder_t);
+	using rid_table_generator_t = RIDTableGeneratorTy;
+	using rid_table_t = typename rid_table_generator_t::rid_table_t;
+	using rid_tuple_t = typename rid_table_t::value_type;
+	using page_cont_t = PageContTy<page_t>;
+	using vertex_t = vertex_template<vertex_id_t, vertex_payload_t>;
+
+	using generate_result = typename rid_table_generator_t::generate_result; // { error, table }
+
+	// num_threads = 0: std::thread::hardware_concurrency()
+	explicit pagedb_from_csr(___size_t num_threads_ = 0);
+
+	/// Zero-degree elision: the pages of rid_table_generator / pagedb_generator with elision enabled (see pagedb.h)
+	inline void enable_zero_degree_elision(bool enabled = true)
+	{
+		elide_zero_degree = enabled;
+	}
+
+	/// Generate: the RID table and the pages of the CSR graph; edge_payloads: one per target (void: nullptr)
+	// Enabled if vertex_payload_t is void type.
+	template <typename OffsetTy, typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value, generate_result>::type generate(const OffsetTy* offsets, ___size_t num_vertices,
+		const vertex_id_t* targets, const edge_payload_t* edge_payloads, vertex_id_t first_vid, page_cont_t& pages);
+	// Enabled if vertex_payload_t is non-void type; vertex_payloads: one per vertex, or nullptr for default_slot_payload
+	template <typename OffsetTy, typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<!std::is_void<PayloadTy>::value, generate_result>::type generate(const OffsetTy* offsets, ___size_t num_vertices,
+		const vertex_id_t* targets, const edge_payload_t* edge_payloads, const PayloadTy* vertex_payloads, PayloadTy default_slot_payload,
+		vertex_id_t first_vid, page_cont_t& pages);
+
+protected:
+	static inline builder_t& builder_of(page_t& page)
+	{
+		return reinterpret_cast<builder_t&>(page);
+	}
+
+	template <typename FnTy>
+	void parallel_for(___size_t count, FnTy fn);
+	template <typename OffsetTy, typename VertexSourceTy>
+	generate_result generate_impl(const OffsetTy* offsets, ___size_t num_vertices, const vertex_id_t* targets, const edge_payload_t* edge_payloads,
+		VertexSourceTy vertex_source, vertex_id_t first_vid, page_cont_t& pages);
+	// Locations of the vertices of page pid
+	void locate_page(const rid_table_t& rid_table, ___size_t pid, vertex_id_t first_vid, ___size_t num_vertices);
+	template <typename OffsetTy, typename VertexSourceTy>
+	void build_page(const rid_table_t& rid_table, ___size_t pid, const OffsetTy* offsets, ___size_t num_vertices, const vertex_id_t* targets,
+		const edge_payload_t* edge_payloads, const VertexSourceTy& vertex_source, vertex_id_t first_vid, page_t& page) const;
+	// Translates targets[first, first + count) into elems[0, count)
+	inline void translate(adj_list_elem_t* elems, const vertex_id_t* targets, const edge_payload_t* edge_payloads, ___size_t first, ___size_t count, vertex_id_t first_vid) const
+	{
+		for (___size_t e = first; e < first + count; ++e)
+			_pagedb_csr::elem_store<adj_list_elem_t, edge_payload_t>::store(*elems++, locations[static_cast<___size_t>(targets[e] - first_vid)], edge_payloads, e);
+	}
+
+	___size_t num_threads;
+	bool      elide_zero_degree{ false };
+	std::vector<adj_list_elem_t> locations; // (page_id, slot_offset) of every vertex; the payload is not used
+};
+
+#define PAGEDB_FROM_CSR_TEMPLATE template <typename PageTy, typename RIDTableGeneratorTy, template <typename _ElemTy, typename > class PageContTy>
+#define PAGEDB_FROM_CSR pagedb_from_csr<PageTy, RIDTableGeneratorTy, PageContTy>
+
+PAGEDB_FROM_CSR_TEMPLATE
+PAGEDB_FROM_CSR::pagedb_from_csr(___size_t num_threads_) :
+	num_threads{ (num_threads_ > 0) ? num_threads_ : std::max<___size_t>(1, std::thread::hardware_concurrency()) }
+{
+}
+
+PAGEDB_FROM_CSR_TEMPLATE
+template <typename FnTy>
+void PAGEDB_FROM_CSR::parallel_for(___size_t count, FnTy fn)
+{
+	const ___size_t num_workers = std::min(num_threads, std::max<___size_t>(1, count));
+	const ___size_t chunk = (count + num_workers - 1) / num_workers;
+	std::vector<std::thread> workers;
+	for (___size_t w = 1; w < num_workers; ++w)
+		workers.emplace_back(fn, std::min(count, w * chunk), std::min(count, (w + 1) * chunk));
+	fn(0, std::min(count, chunk));
+	for (auto& worker : workers)
+		worker.join();
+}
+
+PAGEDB_FROM_CSR_TEMPLATE
+template <typename OffsetTy, typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value, typename PAGEDB_FROM_CSR::generate_result>::type PAGEDB_FROM_CSR::generate(const OffsetTy* offsets, ___size_t num_vertices,
+	const vertex_id_t* targets, const edge_payload_t* edge_payloads, vertex_id_t first_vid, page_cont_t& pages)
+{
+	return generate_impl(offsets, num_vertices, targets, edge_payloads, _pagedb_csr::vertex_source<vertex_t, void>{}, first_vid, pages);
+}
+
+PAGEDB_FROM_CSR_TEMPLATE
+template <typename OffsetTy, typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value, typename PAGEDB_FROM_CSR::generate_result>::type PAGEDB_FROM_CSR::generate(const OffsetTy* offsets, ___size_t num_vertices,
+	const vertex_id_t* targets, const edge_payload_t* edge_payloads, const PayloadTy* vertex_payloads, PayloadTy default_slot_payload,
+	vertex_id_t first_vid, page_cont_t& pages)
+{
+	return generate_impl(offsets, num_vertices, targets, edge_payloads, _pagedb_csr::vertex_source<vertex_t, PayloadTy>{ vertex_payloads, default_slot_payload }, first_vid, pages);
+}
+
+PAGEDB_FROM_CSR_TEMPLATE
+template <typename OffsetTy, typename VertexSourceTy>
+typename PAGEDB_FROM_CSR::generate_result PAGEDB_FROM_CSR::generate_impl(const OffsetTy* offsets, ___size_t num_vertices, const vertex_id_t* targets,
+	const edge_payload_t* edge_payloads, VertexSourceTy vertex_source, vertex_id_t first_vid, page_cont_t& pages)
+{
+	if (0 == num_vertices)
+		return generate_result{ generator_error_t::init_failed_empty_edgeset, rid_table_t{} };
+
+	// (1) RID table
+	std::vector<___size_t> degrees(num_vertices);
+	parallel_for(num_vertices, [&](___size_t begin, ___size_t end) {
+		for (___size_t i = begin; i < end; ++i)
+			degrees[i] = static_cast<___size_t>(offsets[i + 1] - offsets[i]);
+	});
+	rid_table_generator_t rid_generator;
+	rid_generator.enable_zero_degree_elision(elide_zero_degree);
+	generate_result result = rid_generator.generate_parallel(degrees.data(), num_vertices, first_vid, num_threads);
+	const rid_table_t& rid_table = result.table;
+	const ___size_t num_pages = rid_table.size();
+
+	// (2) Locations
+	locations.resize(num_vertices);
+	parallel_for(num_pages, [&](___size_t begin, ___size_t end) {
+		for (___size_t pid = begin; pid < end; ++pid)
+			locate_page(rid_table, pid, first_vid, num_vertices);
+	});
+
+	// (3) Pages
+	pages.resize(num_pages);
+	parallel_for(num_pages, [&](___size_t begin, ___size_t end) {
+		for (___size_t pid = begin; pid < end; ++pid)
+			build_page(rid_table, pid, offsets, num_vertices, targets, edge_payloads, vertex_source, first_vid, pages[pid]);
+	});
+	return result;
+}
+
+PAGEDB_FROM_CSR_TEMPLATE
+void PAGEDB_FROM_CSR::locate_page(const rid_table_t& rid_table, ___size_t pid, vertex_id_t first_vid, ___size_t num_vertices)
+{
+	const ___size_t start = static_cast<___size_t>(rid_table[pid].start_vid - first_vid);
+	if (rid_table[pid].auxiliary != 0) {
+		// Large page: the head holds the vertex, extended pages repeat its start_vid
+		if (pid == 0 || rid_table[pid - 1].start_vid != rid_table[pid].start_vid) {
+			locations[start].page_id = static_cast<page_id_t>(pid);
+			locations[start].slot_offset = 0;
+		}
+		return;
+	}
+	const ___size_t end = (pid + 1 < rid_table.size()) ? static_cast<___size_t>(rid_table[pid + 1].start_vid - first_vid) : num_vertices;
+	for (___size_t v = start; v < end; ++v) {
+		locations[v].page_id = static_cast<page_id_t>(pid);
+		locations[v].slot_offset = static_cast<slot_offset_t>(v - start);
+	}
+}
+
+PAGEDB_FROM_CSR_TEMPLATE
+template <typename OffsetTy, typename VertexSourceTy>
+void PAGEDB_FROM_CSR::build_page(const rid_table_t& rid_table, ___size_t pid, const OffsetTy* offsets, ___size_t num_vertices, const vertex_id_t* targets,
+	const edge_payload_t* edge_payloads, const VertexSourceTy& vertex_source, vertex_id_t first_vid, page_t& page) const
+{
+	// A page of pagedb_generator is zero except for the regions it wrote
+	memset(static_cast<void*>(&page), 0, PageSize);
+	page.footer.rear = DataSectionSize;
+	builder_t& builder = builder_of(page);
+	const rid_tuple_t& tuple = rid_table[pid];
+	const ___size_t start = static_cast<___size_t>(tuple.start_vid - first_vid);
+
+	if (tuple.auxiliary != 0) {
+		const ___size_t first_edge = static_cast<___size_t>(offsets[start]);
+		const ___size_t num_edges = static_cast<___size_t>(offsets[start + 1] - offsets[start]);
+		const vertex_t vertex = vertex_source(tuple.start_vid, start);
+		if (pid == 0 || rid_table[pid - 1].start_vid != tuple.start_vid) {
+			vertex.to_slot(builder);
+			builder.record_size(0) = static_cast<record_size_t>(num_edges);
+			translate(builder.list(0), targets, edge_payloads, first_edge, MaximumEdgesInHeadPage, first_vid);
+			builder.footer.front += static_cast<offset_t>(sizeof(adj_list_elem_t) * MaximumEdgesInHeadPage);
+			builder.flags() = slotted_page_flag::LP_HEAD;
+			return;
+		}
+		// Extended page: auxiliary is the offset from the head page
+		const ___size_t offset = MaximumEdgesInHeadPage + (static_cast<___size_t>(tuple.auxiliary) - 1) * MaximumEdgesInExtPage;
+		___size_t count = num_edges - offset;
+		if (count > MaximumEdgesInExtPage)
+			count = MaximumEdgesInExtPage;
+		vertex.to_slot_ext(builder);
+		translate(builder.list_ext(0), targets, edge_payloads, first_edge + offset, count, first_vid);
+		builder.footer.front += static_cast<offset_t>(sizeof(adj_list_elem_t) * count);
+		builder.flags() = slotted_page_flag::LP_EXTENDED;
+		return;
+	}
+
+	const ___size_t end = (pid + 1 < rid_table.size()) ? static_cast<___size_t>(rid_table[pid + 1].start_vid - first_vid) : num_vertices;
+	bool elided = false;
+	for (___size_t v = start; v < end; ++v) {
+		const ___size_t num_edges = static_cast<___size_t>(offsets[v + 1] - offsets[v]);
+		if (elide_zero_degree && num_edges == 0 && v != start) {
+			elided = true; // no slot (the first vertex of the range always owns one)
+			continue;
+		}
+		vertex_source(static_cast<vertex_id_t>(first_vid + v), v).to_slot(builder);
+		if (num_edges == 0)
+			continue;
+		const offset_t slot = static_cast<offset_t>(builder.number_of_slots() - 1);
+		builder.record_size(slot) = static_cast<record_size_t>(num_edges);
+		translate(builder.list(slot), targets, edge_payloads, static_cast<___size_t>(offsets[v]), num_edges, first_vid);
+		builder.footer.front += static_cast<offset_t>(sizeof(adj_list_elem_t) * num_edges);
+	}
+	builder.flags() = elided ? (slotted_page_flag::SP | slotted_page_flag::ELIDED_VERTICES) : slotted_page_flag::SP;
+}
+
+#undef PAGEDB_FROM_CSR
+#undef PAGEDB_FROM_CSR_TEMPLATE
+
+template <typename PageTy,
+	typename RIDTableTy = typename generator_traits<PageTy>::rid_table_t,
+	typename OffsetTy = std::uint64_t>
+class pagedb_csr_exporter {
+public:
+	using page_t = PageTy;
+	using traits_t = page_traits<page_t>;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(page_t);
+	ALIAS_SLOTTED_PAGE_TEMPLATE_CONSTDEFS(page_t);
+	using rid_table_t = RIDTableTy;
+	using csr_offset_t = OffsetTy;
+
+	struct export_result {
+		generator_error_t error;
+		___size_t num_vertices;
+		___size_t num_edges;
+	};
+
+	// num_threads = 0: std::thread::hardware_concurrency()
+	explicit pagedb_csr_exporter(___size_t num_threads_ = 0);
+
+	/// Export: the CSR arrays of the vertices [rid_table[0].start_vid, + num_vertices) into the given files
+	// pages: any page store with operator[] (std::vector<page_t>, mapped_page_store, numa_page_store);
+	// payloads_path is ignored for a void edge payload; overflow_pages: the overflow store (nullptr: none);
+	// num_vertices = 0: up to the last slot of the last page (give it when the last page ends with elided vertices);
+	// init_failed_vertex_range if num_vertices is less than that
+	template <typename PageStoreTy>
+	export_result export_csr(PageStoreTy& pages, const rid_table_t& rid_table, const char* offsets_path, const char* targets_path,
+		const char* payloads_path = nullptr, page_t* overflow_pages = nullptr, ___size_t num_vertices = 0);
+
+protected:
+	template <typename FnTy>
+	void parallel_for(___size_t count, FnTy fn);
+	// The mapped output array of 'count' elements; an empty file for count = 0
+	template <typename ElemTy>
+	static ElemTy* create_array(mapped_file& file, const char* filepath, ___size_t count, bool& succeeded);
+	static inline bool is_lp_ext(const rid_table_t& rid_table, ___size_t pid)
+	{
+		return rid_table[pid].auxiliary != 0 && pid > 0 && rid_table[pid - 1].start_vid == rid_table[pid].start_vid;
+	}
+
+	___size_t num_threads;
+};
+
+#define PAGEDB_CSR_EXPORTER_TEMPLATE template <typename PageTy, typename RIDTableTy, typename OffsetTy>
+#define PAGEDB_CSR_EXPORTER pagedb_csr_exporter<PageTy, RIDTableTy, OffsetTy>
+
+PAGEDB_CSR_EXPORTER_TEMPLATE
+PAGEDB_CSR_EXPORTER::pagedb_csr_exporter(___size_t num_threads_) :
+	num_threads{ (num_threads_ > 0) ? num_threads_ : std::max<___size_t>(1, std::thread::hardware_concurrency()) }
+{
+}
+
+PAGEDB_CSR_EXPORTER_TEMPLATE
+template <typename FnTy>
+void PAGEDB_CSR_EXPORTER::parallel_for(___size_t count, FnTy fn)
+{
+	const ___size_t num_workers = std::min(num_threads, std::max<___size_t>(1, count));
+	const ___size_t chunk = (count + num_workers - 1) / num_workers;
+	std::vector<std::thread> workers;
+	for (___size_t w = 1; w < num_workers; ++w)
+		workers.emplace_back(fn, w, std::min(count, w * chunk), std::min(count, (w + 1) * chunk));
+	fn(0, 0, std::min(count, chunk));
+	for (auto& worker : workers)
+		worker.join();
+}
+
+PAGEDB_CSR_EXPORTER_TEMPLATE
+template <typename ElemTy>
+ElemTy* PAGEDB_CSR_EXPORTER::create_array(mapped_file& file, const char* filepath, ___size_t count, bool& succeeded)
+{
+	if (count == 0) {
+		// A mapping cannot be empty
+		std::ofstream ofs{ filepath, std::ios::out | std::ios::binary | std::ios::trunc };
+		succeeded = succeeded && ofs.is_open();
+		return nullptr;
+	}
+	if (!file.create(filepath, sizeof(ElemTy) * count)) {
+		succeeded = false;
+		return nullptr;
+	}
+	return reinterpret_cast<ElemTy*>(file.data());
+}
+
+PAGEDB_CSR_EXPORTER_TEMPLATE
+template <typename PageStoreTy>
+typename PAGEDB_CSR_EXPORTER::export_result PAGEDB_CSR_EXPORTER::export_csr(PageStoreTy& pages, const rid_table_t& rid_table,
+	const char* offsets_path, const char* targets_path, const char* payloads_path, page_t* overflow_pages, ___size_t num_vertices)
+{
+	using load_t = _pagedb_csr::run_load<adj_list_elem_t, edge_payload_t>;
+	using payload_store_t = typename std::conditional<std::is_void<edge_payload_t>::value, char, edge_payload_t>::type; // never created if void
+	export_result result{ generator_error_t::success, 0, 0 };
+	const ___size_t num_pages = rid_table.size();
+	if (num_pages == 0) {
+		result.error = generator_error_t::init_failed_empty_pagedb;
+		return result;
+	}
+	const vertex_id_t first_vid = rid_table[0].start_vid;
+	const ___size_t last = num_pages - 1;
+	// The vertices of the pages; a given num_vertices may add elided vertices after the last slot, but never drop a vertex
+	const ___size_t num_slotted_vertices = 1 + static_cast<___size_t>(((rid_table[last].auxiliary != 0) ? rid_table[last].start_vid
+		: pages[last].slot(static_cast<offset_t>(pages[last].number_of_slots() - 1)).vertex_id) - first_vid);
+	if (num_vertices == 0)
+		num_vertices = num_slotted_vertices;
+	if (num_vertices < num_slotted_vertices) {
+		result.error = generator_error_t::init_failed_vertex_range;
+		return result;
+	}
+	result.num_vertices = num_vertices;
+	// Index of the first vertex of page pid, and of the vertex in slot s of a small page
+	auto index_of = [&](___size_t pid) {
+		return static_cast<___size_t>(rid_table[pid].start_vid - first_vid);
+	};
+	auto index_of_slot = [&](page_t& page, offset_t s) {
+		return static_cast<___size_t>(page.slot(s).vertex_id - first_vid);
+	};
+
+	bool succeeded = true;
+	mapped_file offsets_file;
+	csr_offset_t* offsets = create_array<csr_offset_t>(offsets_file, offsets_path, num_vertices + 1, succeeded);
+	if (!succeeded) {
+		result.error = generator_error_t::write_failed;
+		return result;
+	}
+
+	// (1) Degrees into offsets[v + 1]
+	offsets[0] = 0;
+	parallel_for(num_pages, [&](___size_t, ___size_t begin, ___size_t end) {
+		for (___size_t pid = begin; pid < end; ++pid) {
+			if (is_lp_ext(rid_table, pid))
+				continue;
+			page_t& page = pages[pid];
+			if (page.is_lp_head()) {
+				offsets[index_of(pid) + 1] = static_cast<csr_offset_t>(page.record_size(static_cast<offset_t>(0)));
+			}
+			else {
+				// Zero-degree elision: the vertices of the range without a slot have no edges
+				const ___size_t range_end = (pid + 1 < num_pages) ? index_of(pid + 1) : num_vertices;
+				if (index_of(pid) + page.number_of_slots() < range_end)
+					std::fill(offsets + index_of(pid) + 1, offsets + range_end + 1, csr_offset_t{ 0 });
+				for (offset_t s = 0; s < page.number_of_slots(); ++s)
+					offsets[index_of_slot(page, s) + 1] = static_cast<csr_offset_t>(page.record_size(s));
+			}
+			if (overflow_pages == nullptr)
+				continue;
+			for (uint32_t link = page.overflow_link(); link != 0; link = overflow_pages[link - 1].overflow_link()) {
+				page_t& spill = overflow_pages[link - 1];
+				for (offset_t s = 0; s < spill.number_of_slots(); ++s)
+					offsets[static_cast<___size_t>(spill.slot(s).vertex_id - first_vid) + 1] += static_cast<csr_offset_t>(spill.record_size(s));
+			}
+		}
+	});
+
+	// (2) Prefix sum: the sums of the worker ranges, then the ranges are scanned from their base
+	std::vector<csr_offset_t> range_sums(num_threads + 1, 0);
+	parallel_for(num_vertices, [&](___size_t worker, ___size_t begin, ___size_t end) {
+		csr_offset_t sum = 0;
+		for (___size_t v = begin; v < end; ++v)
+			sum += offsets[v + 1];
+		range_sums[worker + 1] = sum;
+	});
+	for (___size_t w = 1; w <= num_threads; ++w)
+		range_sums[w] += range_sums[w - 1];
+	parallel_for(num_vertices, [&](___size_t worker, ___size_t begin, ___size_t end) {
+		csr_offset_t sum = range_sums[worker];
+		for (___size_t v = begin; v < end; ++v) {
+			sum += offsets[v + 1];
+			offsets[v + 1] = sum;
+		}
+	});
+	result.num_edges = static_cast<___size_t>(offsets[num_vertices]);
+
+	// (3) Runs
+	mapped_file targets_file, payloads_file;
+	vertex_id_t* targets = create_array<vertex_id_t>(targets_file, targets_path, result.num_edges, succeeded);
+	payload_store_t* payloads = nullptr;
+	if (EdgePayloadSize != 0 && payloads_path != nullptr)
+		payloads = create_array<payload_store_t>(payloads_file, payloads_path, result.num_edges, succeeded);
+	if (!succeeded) {
+		result.error = generator_error_t::write_failed;
+		return result;
+	}
+	parallel_for(num_pages, [&](___size_t, ___size_t begin, ___size_t end) {
+		std::vector<csr_offset_t> cursor; // per vertex of the page: where the next spilled list of the vertex goes
+		auto store = [&](const adj_list_elem_t* elems, ___size_t count, csr_offset_t at) {
+			if (count == 0)
+				return;
+			load_t::load(elems, count, rid_table, targets, payloads, static_cast<___size_t>(at));
+		};
+		for (___size_t pid = begin; pid < end; ++pid) {
+			if (is_lp_ext(rid_table, pid))
+				continue;
+			page_t& page = pages[pid];
+			const ___size_t first = index_of(pid);
+			if (page.is_lp_head()) {
+				csr_offset_t at = offsets[first];
+				const ___size_t in_head = (page.footer.front - sizeof(record_size_t)) / sizeof(adj_list_elem_t);
+				store(page.list(0), in_head, at);
+				at += static_cast<csr_offset_t>(in_head);
+				const ___size_t num_ext = static_cast<___size_t>(rid_table[pid].auxiliary);
+				for (___size_t ext = pid + 1; ext <= pid + num_ext; ++ext) {
+					page_t& ext_page = pages[ext];
+					const ___size_t in_page = ext_page.footer.front / sizeof(adj_list_elem_t);
+					store(ext_page.list_ext(0), in_page, at);
+					at += static_cast<csr_offset_t>(in_page);
+				}
+				cursor.assign(1, at);
+			}
+			else {
+				const offset_t num_slots = page.number_of_slots();
+				cursor.resize(index_of_slot(page, static_cast<offset_t>(num_slots - 1)) - first + 1);
+				for (offset_t s = 0; s < num_slots; ++s) {
+					const ___size_t v = index_of_slot(page, s);
+					const ___size_t count = static_cast<___size_t>(page.record_size(s));
+					store(page.list(s), count, offsets[v]);
+					cursor[v - first] = offsets[v] + static_cast<csr_offset_t>(count);
+				}
+			}
+			if (overflow_pages == nullptr)
+				continue;
+			for (uint32_t link = page.overflow_link(); link != 0; link = overflow_pages[link - 1].overflow_link()) {
+				page_t& spill = overflow_pages[link - 1];
+				for (offset_t s = 0; s < spill.number_of_slots(); ++s) {
+					const ___size_t count = static_cast<___size_t>(spill.record_size(s));
+					csr_offset_t& at = cursor[static_cast<___size_t>(spill.slot(s).vertex_id - first_vid) - first];
+					store(spill.list(s), count, at);
+					at += static_cast<csr_offset_t>(count);
+				}
+			}
+		}
+	});
+
+	succeeded = offsets_file.flush() && (result.num_edges == 0 || targets_file.flush()) && (!payloads_file.is_open() || payloads_file.flush());
+	if (!succeeded)
+		result.error = generator_error_t::write_failed;
+	return result;
+}
+
+#undef PAGEDB_CSR_EXPORTER
+#undef PAGEDB_CSR_EXPORTER_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGEDB_CSR_H_
@@ -0,0 +1,425 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		pagedb_partition.h
+*	@brief		Edge-cut partitioner producing per-partition PageDB shards
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGEDB_PARTITION_H_
+#define _GSTREAM_DATATYPE_PAGEDB_PARTITION_H_
+
+#include <gstream/datatype/pagedb.h>
+#include <gstream/datatype/vertex_reorder.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+/* ---------------------------------------------------------------
+**
+** Partitioned PageDB
+** Vertices are split into K shards; each shard is an ordinary PageDB
+** (pages + RID table) over shard-local vertex IDs 0..n_k-1, which
+** preserve the relative order of the original IDs.
+**
+** Cross-shard references
+** Adjacency elements address a global page space in which the pages
+** of shard k occupy [page_base_k, page_base_k + num_pages_k).
+** An element (page_id, slot_offset) therefore encodes
+** (shard, page_id - page_base_shard, slot_offset); locate_shard()
+** decodes it. A worker maps only its own shard and forwards
+** elements outside of its page range to the owner.
+** The pages of a shard are those of a pagedb_generator over the
+** local vertex range, with an edge translator which locates the
+** destination in the RID table of its shard.
+**
+** Files written by write_shards(prefix):
+**   <prefix>.<k>.pages, <prefix>.<k>.rid_table
+**   <prefix>.<k>.vertex_map  (original vertex ids by local id)
+**   <prefix>.shards          (uint64 page_base, num_pages, num_vertices per shard)
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+enum class partition_method_t {
+	range,  // contiguous vertex ranges balanced by (out-degree + 1)
+	hash,   // hash of the vertex id
+	ldg,    // streaming Linear Deterministic Greedy
+	fennel, // streaming Fennel
+};
+
+template <typename PageTy,
+	typename RIDTableTy = typename generator_traits<PageTy>::rid_table_t,
+	template <typename _ElemTy,
+	typename = std::allocator<_ElemTy> >
+	class PageContTy = std::vector >
+class pagedb_partitioner {
+public:
+	using page_t = PageTy;
+	using traits_t = page_traits<page_t>;
+	using builder_t = typename traits_t::page_builder_t;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(builder_t);
+	ALIAS_SLOTTED_PAGE_TEMPLATE_CONSTDEFS(builder_t);
+	using rid_table_t = RIDTableTy;
+	using rid_tuple_t = typename rid_table_t::value_type;
+	using page_cont_t = PageContTy<page_t>;
+	using edge_t = typename traits_t::edge_t;
+	using vertex_t = typename traits_t::vertex_t;
+	using shard_id_t = std::uint32_t;
+	using pagedb_generator_t = pagedb_generator<builder_t, rid_table_t>;
+
+	struct shard_t {
+		page_cont_t              pages;
+		rid_table_t              rid_table;
+		std::vector<vertex_id_t> global_ids; // original vertex id by local vertex id
+		___size_t                page_base;  // first page id of this shard in the global page space
+	};
+
+	struct partition_result {
+		generator_error_t error;
+		___size_t num_vertices;
+		___size_t num_edges;
+		___size_t num_cut_edges; // edges whose endpoints belong to different shards
+	};
+
+	pagedb_partitioner(shard_id_t num_shards_, partition_method_t method_ = partition_method_t::range, double imbalance_ = 0.05);
+
+	/// Partition: sorted_edges must be sorted by src. sorted_vertices (optional) carry vertex payloads,
+	// vertices without an entry take default_vertex. failed_field_overflow (and no page is built)
+	// if the global page space of the shards does not fit in page_id_t.
+	partition_result partition(const edge_t* sorted_edges, ___size_t num_edges, const vertex_t* sorted_vertices, ___size_t num_vertices, const vertex_t& default_vertex);
+	partition_result partition(const edge_t* sorted_edges, ___size_t num_edges)
+	{
+		return partition(sorted_edges, num_edges, nullptr, 0, vertex_t{});
+	}
+
+	inline shard_id_t number_of_shards() const
+	{
+		return num_shards;
+	}
+	inline std::vector<shard_t>& shards()
+	{
+		return shard_list;
+	}
+	// Shard of an original vertex id
+	inline shard_id_t shard_of(vertex_id_t vid) const
+	{
+		return assignment[vid];
+	}
+	inline vertex_id_t local_id(vertex_id_t vid) const
+	{
+		return local_ids[vid];
+	}
+	/// Locate: global page id -> (shard, local page id)
+	std::pair<shard_id_t, page_id_t> locate_shard(page_id_t page_id) const;
+
+	bool write_shards(const char* prefix);
+
+protected:
+	void assign(const edge_t* edges, ___size_t num_edges, ___size_t num_vertices);
+	void assign_streaming(const edge_t* edges, ___size_t num_edges, ___size_t num_vertices);
+	generator_error_t build_shard(shard_id_t shard, const edge_t* edges, const std::vector<___size_t>& edge_offsets,
+		const vertex_t* sorted_vertices, ___size_t num_vertices, const vertex_t& default_vertex);
+	void translate(const edge_t& edge, adj_list_elem_t* out) const;
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type run_generator(pagedb_generator_t& generator,
+		typename pagedb_generator_t::edge_iterator_t edge_iterator, typename pagedb_generator_t::vertex_iterator_t vertex_iterator, const vertex_t& default_vertex, std::ostream& os);
+	template <typename PayloadTy = vertex_payload_t>
+	typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type run_generator(pagedb_generator_t& generator,
+		typename pagedb_generator_t::edge_iterator_t edge_iterator, typename pagedb_generator_t::vertex_iterator_t vertex_iterator, const vertex_t& default_vertex, std::ostream& os);
+
+	shard_id_t               num_shards;
+	partition_method_t       method;
+	double                   imbalance;
+	std::vector<shard_id_t>  assignment; // indexed by original vertex id
+	std::vector<vertex_id_t> local_ids;  // indexed by original vertex id
+	std::vector<shard_t>     shard_list;
+};
+
+#define PAGEDB_PARTITIONER_TEMPLATE template <typename PageTy, typename RIDTableTy, template <typename _ElemTy, typename > class PageContTy>
+#define PAGEDB_PARTITIONER pagedb_partitioner<PageTy, RIDTableTy, PageContTy>
+
+PAGEDB_PARTITIONER_TEMPLATE
+PAGEDB_PARTITIONER::pagedb_partitioner(shard_id_t num_shards_, partition_method_t method_, double imbalance_) :
+	num_shards{ (num_shards_ > 0) ? num_shards_ : 1 },
+	method{ method_ },
+	imbalance{ imbalance_ }
+{
+}
+
+PAGEDB_PARTITIONER_TEMPLATE
+typename PAGEDB_PARTITIONER::partition_result PAGEDB_PARTITIONER::partition(const edge_t* sorted_edges, ___size_t num_edges, const vertex_t* sorted_vertices, ___size_t num_vertices, const vertex_t& default_vertex)
+{
+	partition_result result{ generator_error_t::success, 0, num_edges, 0 };
+	if (0 == num_edges) {
+		result.error = generator_error_t::init_failed_empty_edgeset;
+		return result;
+	}
+
+	// Vertex id space: [0, max vertex id]
+	___size_t total_vertices = 0;
+	for (___size_t i = 0; i < num_edges; ++i)
+		total_vertices = std::max<___size_t>(total_vertices, static_cast<___size_t>(std::max(sorted_edges[i].src, sorted_edges[i].dst)) + 1);
+	if (num_vertices > 0)
+		total_vertices = std::max<___size_t>(total_vertices, static_cast<___size_t>(sorted_vertices[num_vertices - 1].vertex_id) + 1);
+	result.num_vertices = total_vertices;
+
+	assign(sorted_edges, num_edges, total_vertices);
+
+	// Shard-local ids preserve the original order
+	std::vector<___size_t> shard_sizes(num_shards, 0);
+	local_ids.resize(total_vertices);
+	shard_list.assign(num_shards, shard_t{});
+	for (___size_t vid = 0; vid < total_vertices; ++vid) {
+		local_ids[vid] = static_cast<vertex_id_t>(shard_sizes[assignment[vid]]++);
+		shard_list[assignment[vid]].global_ids.push_back(static_cast<vertex_id_t>(vid));
+	}
+
+	// Out-edge offsets of every vertex in the sorted edge array
+	std::vector<___size_t> edge_offsets(total_vertices + 1, 0);
+	for (___size_t i = 0; i < num_edges; ++i) {
+		++edge_offsets[static_cast<___size_t>(sorted_edges[i].src) + 1];
+		if (assignment[sorted_edges[i].src] != assignment[sorted_edges[i].dst])
+			++result.num_cut_edges;
+	}
+	for (___size_t vid = 0; vid < total_vertices; ++vid)
+		edge_offsets[vid + 1] += edge_offsets[vid];
+
+	// RID tables from the local degrees; every shard needs all tables to resolve its references
+	using rid_generator_t = rid_table_generator<page_t, typename rid_tuple_t::auxiliary_t>;
+	___size_t page_base = 0;
+	for (shard_id_t shard = 0; shard < num_shards; ++shard) {
+		shard_t& s = shard_list[shard];
+		s.page_base = page_base;
+		if (s.global_ids.empty())
+			continue;
+		std::vector<___size_t> degrees(s.global_ids.size());
+		for (___size_t local = 0; local < degrees.size(); ++local)
+			degrees[local] = edge_offsets[s.global_ids[local] + 1] - edge_offsets[s.global_ids[local]];
+		rid_generator_t rid_generator;
+		auto generate_result = rid_generator.generate(degrees.data(), degrees.size(), 0);
+		s.rid_table.insert(s.rid_table.end(), generate_result.table.begin(), generate_result.table.end());
+		page_base += s.rid_table.size();
+	}
+	// Every element addresses the global page space, so its last page id must fit in page_id_t
+	if (page_base - 1 > static_cast<___size_t>(std::numeric_limits<page_id_t>::max())) {
+		result.error = generator_error_t::failed_field_overflow;
+		return result;
+	}
+
+	// Pages: one thread per shard
+	std::vector<generator_error_t> errors(num_shards, generator_error_t::success);
+	std::vector<std::thread> workers;
+	for (shard_id_t shard = 0; shard < num_shards; ++shard)
+		workers.emplace_back([&, shard]() {
+			errors[shard] = this->build_shard(shard, sorted_edges, edge_offsets, sorted_vertices, num_vertices, default_vertex);
+		});
+	for (auto& worker : workers)
+		worker.join();
+	for (auto error : errors)
+		if (error != generator_error_t::success)
+			result.error = error;
+	return result;
+}
+
+PAGEDB_PARTITIONER_TEMPLATE
+void PAGEDB_PARTITIONER::assign(const edge_t* edges, ___size_t num_edges, ___size_t num_vertices)
+{
+	assignment.assign(num_vertices, 0);
+	switch (method) {
+	case partition_method_t::range: {
+		// Cut the (out-degree + 1) prefix sum into K equal ranges
+		std::vector<___size_t> weights(num_vertices, 1);
+		for (___size_t i = 0; i < num_edges; ++i)
+			++weights[edges[i].src];
+		const double total = static_cast<double>(num_edges + num_vertices);
+		double prefix = 0.0;
+		for (___size_t vid = 0; vid < num_vertices; ++vid) {
+			assignment[vid] = std::min<shard_id_t>(num_shards - 1, static_cast<shard_id_t>(prefix * num_shards / total));
+			prefix += static_cast<double>(weights[vid]);
+		}
+		break;
+	}
+	case partition_method_t::hash:
+		for (___size_t vid = 0; vid < num_vertices; ++vid) {
+			std::uint64_t h = static_cast<std::uint64_t>(vid) * 0x9E3779B97F4A7C15ull;
+			assignment[vid] = static_cast<shard_id_t>((h ^ (h >> 32)) % num_shards);
+		}
+		break;
+	case partition_method_t::ldg:
+	case partition_method_t::fennel:
+		assign_streaming(edges, num_edges, num_vertices);
+		break;
+	}
+}
+
+PAGEDB_PARTITIONER_TEMPLATE
+void PAGEDB_PARTITIONER::assign_streaming(const edge_t* edges, ___size_t num_edges, ___size_t num_vertices)
+{
+	std::vector<___size_t> offsets, neighbors;
+	_vertex_reorder::build_undirected_csr(edges, num_edges, num_vertices, offsets, neighbors);
+
+	const double capacity = std::ceil(static_cast<double>(num_vertices) * (1.0 + imbalance) / num_shards);
+	// Fennel: c(x) = alpha * x^gamma, gamma = 1.5, alpha = sqrt(K) * |E| / |V|^1.5
+	const double gamma = 1.5;
+	const double alpha = std::sqrt(static_cast<double>(num_shards)) * static_cast<double>(num_edges) / std::pow(static_cast<double>(num_vertices), gamma);
+
+	std::vector<___size_t> sizes(num_shards, 0);
+	std::vector<___size_t> counts(num_shards, 0);
+	std::vector<bool> assigned(num_vertices, false);
+	for (___size_t vid = 0; vid < num_vertices; ++vid) {
+		std::fill(counts.begin(), counts.end(), 0);
+		for (___size_t i = offsets[vid]; i < offsets[vid + 1]; ++i)
+			if (assigned[neighbors[i]])
+				++counts[assignment[neighbors[i]]];
+
+		shard_id_t best = 0;
+		double best_score = 0.0;
+		bool found = false;
+		for (shard_id_t shard = 0; shard < num_shards; ++shard) {
+			if (static_cast<double>(sizes[shard]) >= capacity)
+				continue;
+			double score = (method == partition_method_t::ldg) ?
+				static_cast<double>(counts[shard]) * (1.0 - static_cast<double>(sizes[shard]) / capacity) :
+				static_cast<double>(counts[shard]) - alpha * gamma * std::sqrt(static_cast<double>(sizes[shard]));
+			// Ties go to the smaller shard
+			if (!found || score > best_score || (score == best_score && sizes[shard] < sizes[best])) {
+				best = shard;
+				best_score = score;
+				found = true;
+			}
+		}
+		assignment[vid] = best;
+		assigned[vid] = true;
+		++sizes[best];
+	}
+}
+
+PAGEDB_PARTITIONER_TEMPLATE
+void PAGEDB_PARTITIONER::translate(const edge_t& edge, adj_list_elem_t* out) const
+{
+	const shard_t& target = shard_list[assignment[edge.dst]];
+	auto location = find_vertex_page<builder_t>(local_ids[edge.dst], target.rid_table);
+	// The global page space is checked against page_id_t by partition()
+	edge.template to_adj_elem<builder_t>(static_cast<page_id_t>(location.first + target.page_base), location.second, out);
+}
+
+PAGEDB_PARTITIONER_TEMPLATE
+template <typename PayloadTy>
+typename std::enable_if<std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_PARTITIONER::run_generator(pagedb_generator_t& generator,
+	typename pagedb_generator_t::edge_iterator_t edge_iterator, typename pagedb_generator_t::vertex_iterator_t, const vertex_t&, std::ostream& os)
+{
+	return generator.generate(edge_iterator, os);
+}
+
+PAGEDB_PARTITIONER_TEMPLATE
+template <typename PayloadTy>
+typename std::enable_if<!std::is_void<PayloadTy>::value, generator_error_t>::type PAGEDB_PARTITIONER::run_generator(pagedb_generator_t& generator,
+	typename pagedb_generator_t::edge_iterator_t edge_iterator, typename pagedb_generator_t::vertex_iterator_t vertex_iterator, const vertex_t& default_vertex, std::ostream& os)
+{
+	return generator.generate(edge_iterator, vertex_iterator, default_vertex.payload, os);
+}
+
+PAGEDB_PARTITIONER_TEMPLATE
+generator_error_t PAGEDB_PARTITIONER::build_shard(shard_id_t shard, const edge_t* edges, const std::vector<___size_t>& edge_offsets,
+	const vertex_t* sorted_vertices, ___size_t num_vertices, const vertex_t& default_vertex)
+{
+	using edge_iteration_result_t = typename pagedb_generator_t::edge_iteration_result_t;
+	using vertex_iteration_result_t = typename pagedb_generator_t::vertex_iteration_result_t;
+	shard_t& s = shard_list[shard];
+	if (s.global_ids.empty())
+		return generator_error_t::success;
+	const vertex_id_t last_local = static_cast<vertex_id_t>(s.global_ids.size() - 1);
+
+	// Edges of the shard by local source id; the destinations stay original ids and are translated to the global page space
+	___size_t edge_cursor = 0;
+	auto edge_iterator = [&]() -> edge_iteration_result_t {
+		typename pagedb_generator_t::edgeset_t edgeset;
+		for (; edge_cursor < s.global_ids.size() && edgeset.empty(); ++edge_cursor) {
+			const vertex_id_t vid = s.global_ids[edge_cursor];
+			for (___size_t i = edge_offsets[vid]; i < edge_offsets[vid + 1]; ++i) {
+				edgeset.push_back(edges[i]);
+				edgeset.back().src = static_cast<vertex_id_t>(edge_cursor);
+			}
+		}
+		return std::make_pair(edgeset, last_local);
+	};
+
+	// Vertex payloads of the shard by local id, looked up in the (sorted) vertex set
+	___size_t vertex_cursor = 0;
+	const vertex_t* vertex_it = sorted_vertices;
+	const vertex_t* vertex_end = sorted_vertices + num_vertices;
+	auto vertex_iterator = [&]() -> vertex_iteration_result_t {
+		for (; vertex_cursor < s.global_ids.size() && vertex_it != vertex_end; ++vertex_cursor) {
+			const vertex_id_t vid = s.global_ids[vertex_cursor];
+			vertex_it = std::lower_bound(vertex_it, vertex_end, vid, [](const vertex_t& v, vertex_id_t id) { return v.vertex_id < id; });
+			if (vertex_it != vertex_end && vertex_it->vertex_id == vid) {
+				vertex_t vertex = *vertex_it;
+				vertex.vertex_id = static_cast<vertex_id_t>(vertex_cursor++);
+				return std::make_pair(true, vertex);
+			}
+		}
+		return std::make_pair(false, vertex_t{});
+	};
+
+	pagedb_generator_t generator{ s.rid_table };
+	generator.set_vertex_range(0, s.global_ids.size());
+	generator.set_edge_translator([this](const edge_t& edge, adj_list_elem_t* out) { this->translate(edge, out); });
+	std::stringstream pages_stream{ std::ios::in | std::ios::out | std::ios::binary };
+	generator_error_t error = run_generator(generator, edge_iterator, vertex_iterator, default_vertex, pages_stream);
+	if (error != generator_error_t::success)
+		return error;
+
+	const std::string bytes = pages_stream.str();
+	s.pages.resize(bytes.size() / PageSize);
+	for (___size_t pid = 0; pid < s.pages.size(); ++pid)
+		memcpy(static_cast<void*>(&s.pages[pid]), bytes.data() + pid * PageSize, PageSize);
+
+	// The pages must agree with the RID table built from the degrees
+	return (s.pages.size() == s.rid_table.size()) ? generator_error_t::success : generator_error_t::write_failed;
+}
+
+PAGEDB_PARTITIONER_TEMPLATE
+std::pair<typename PAGEDB_PARTITIONER::shard_id_t, typename PAGEDB_PARTITIONER::page_id_t> PAGEDB_PARTITIONER::locate_shard(page_id_t page_id) const
+{
+	shard_id_t shard = 0;
+	while (shard + 1 < num_shards && shard_list[shard + 1].page_base <= static_cast<___size_t>(page_id))
+		++shard;
+	return std::make_pair(shard, static_cast<page_id_t>(page_id - shard_list[shard].page_base));
+}
+
+PAGEDB_PARTITIONER_TEMPLATE
+bool PAGEDB_PARTITIONER::write_shards(const char* prefix)
+{
+	std::string manifest_path{ prefix };
+	manifest_path += ".shards";
+	std::ofstream manifest{ manifest_path, std::ios::out | std::ios::binary | std::ios::trunc };
+	for (shard_id_t shard = 0; shard < num_shards; ++shard) {
+		shard_t& s = shard_list[shard];
+		std::string path{ prefix };
+		path += "." + std::to_string(shard);
+		std::ofstream pages_ofs{ path + ".pages", std::ios::out | std::ios::binary | std::ios::trunc };
+		write_pages(s.pages, pages_ofs);
+		std::ofstream rid_table_ofs{ path + ".rid_table", std::ios::out | std::ios::binary | std::ios::trunc };
+		write_rid_table(s.rid_table, rid_table_ofs);
+		std::ofstream vertex_map_ofs{ path + ".vertex_map", std::ios::out | std::ios::binary | std::ios::trunc };
+		vertex_map_ofs.write(reinterpret_cast<const char*>(s.global_ids.data()), static_cast<std::streamsize>(sizeof(vertex_id_t) * s.global_ids.size()));
+
+		std::uint64_t meta[3] = { s.page_base, s.pages.size(), s.global_ids.size() };
+		manifest.write(reinterpret_cast<const char*>(meta), sizeof(meta));
+		if (!pages_ofs.good() || !rid_table_ofs.good() || !vertex_map_ofs.good())
+			return false;
+	}
+	return manifest.good();
+}
+
+#undef PAGEDB_PARTITIONER
+#undef PAGEDB_PARTITIONER_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGEDB_PARTITION_H_
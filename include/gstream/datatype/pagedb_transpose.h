@@ -0,0 +1,423 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		pagedb_transpose.h
+*	@brief		In-edge (transposed) PageDB with the layout of the forward PageDB
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGEDB_TRANSPOSE_H_
+#define _GSTREAM_DATATYPE_PAGEDB_TRANSPOSE_H_
+
+#include <gstream/datatype/pagedb.h>
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+/* ---------------------------------------------------------------
+**
+** Transposed PageDB
+** The in-edge PageDB reuses the RID table of the forward PageDB:
+** every vertex keeps its (page_id, slot_offset), so that a
+** page_state_array (or any state indexed by page/slot) is shared by
+** the forward and the transposed PageDB. Page i of the transposed
+** PageDB holds the in-edge lists of the vertices of forward page i,
+** and its adjacency elements point to the source vertices.
+**
+** An in-list which does not fit in the page (chain) of its vertex is
+** spilled to an overflow store, in the format of pagedb_updater:
+** SP|OVERFLOW_PAGE pages linked from the base page by
+** overflow_link(). The slots of a small page share its free space in
+** slot order.
+**
+** Build
+** (1) Count: every worker scans a range of forward pages (and their
+**     overflow chains) and counts the reversed edges per bucket of
+**     destination pages.
+** (2) Scatter: prefix sums over (bucket, worker) give every worker a
+**     private range of each bucket; the records are copied there in
+**     page order, so that the buckets are filled without locks and
+**     without a global sort.
+** (3) Build: every bucket is sorted by (destination, source) and its
+**     pages are built in parallel; the overflow pages of the buckets
+**     are concatenated at the end.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+template <typename PageTy,
+	typename RIDTableTy = typename generator_traits<PageTy>::rid_table_t,
+	template <typename _ElemTy,
+	typename = std::allocator<_ElemTy> >
+	class PageContTy = std::vector >
+class pagedb_transposer {
+public:
+	using page_t = PageTy;
+	using traits_t = page_traits<page_t>;
+	using builder_t = typename traits_t::page_builder_t;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(builder_t);
+	ALIAS_SLOTTED_PAGE_TEMPLATE_CONSTDEFS(builder_t);
+	using rid_table_t = RIDTableTy;
+	using rid_tuple_t = typename rid_table_t::value_type;
+	using page_cont_t = PageContTy<page_t>;
+
+	struct transpose_result {
+		generator_error_t error;
+		___size_t num_edges;
+		___size_t num_spilled;        // in-edges stored in the overflow store
+		___size_t num_overflow_pages;
+	};
+
+	// num_threads = 0: std::thread::hardware_concurrency()
+	explicit pagedb_transposer(___size_t num_threads_ = 0, ___size_t buckets_per_thread_ = 8);
+
+	/// Transpose: build the in-edge PageDB (in_pages, in_overflow_pages) of (pages, overflow_pages) on the same rid_table;
+	// init_failed_elided_pagedb if the PageDB was generated with zero-degree elision,
+	// failed_field_overflow (and both outputs are empty) if the overflow store needs more than 2^32 - 1 pages
+	transpose_result transpose(page_cont_t& pages, page_cont_t& overflow_pages, const rid_table_t& rid_table, page_cont_t& in_pages, page_cont_t& in_overflow_pages);
+
+protected:
+	struct in_record {
+		page_id_t       dst_page; // head page of the destination vertex
+		slot_offset_t   dst_slot;
+		adj_list_elem_t elem;     // points to the source vertex
+	};
+	struct bucket_t {
+		std::vector<in_record> records;
+		std::vector<page_t>    overflow_pages; // links are local: 1 + index in this bucket
+		___size_t              num_spilled;
+	};
+
+	static inline ___size_t max_record_size()
+	{
+		return static_cast<___size_t>(std::numeric_limits<record_size_t>::max());
+	}
+	static inline ___size_t max_overflow_link()
+	{
+		return static_cast<___size_t>(std::numeric_limits<uint32_t>::max());
+	}
+	static inline builder_t& builder_of(page_t& page)
+	{
+		return reinterpret_cast<builder_t&>(page);
+	}
+	inline ___size_t bucket_of(___size_t pid) const
+	{
+		return pid / pages_per_bucket;
+	}
+
+	template <typename FnTy>
+	void parallel_for(___size_t count, FnTy fn);
+	// fn(source head page, source slot, const adj_list_elem_t&) for the out-edges stored in the forward page pid
+	template <typename FnTy>
+	void for_each_edge(page_cont_t& pages, page_cont_t& overflow_pages, const rid_table_t& rid_table, ___size_t pid, FnTy fn) const;
+	void build_bucket(bucket_t& bucket, page_cont_t& pages, const rid_table_t& rid_table, page_cont_t& in_pages, ___size_t first_page, ___size_t last_page);
+	void spill(bucket_t& bucket, page_t& owner, const slot_t& owner_slot, const adj_list_elem_t* elems, ___size_t count);
+
+	___size_t num_threads;
+	___size_t buckets_per_thread;
+	___size_t pages_per_bucket;
+};
+
+#define PAGEDB_TRANSPOSER_TEMPLATE template <typename PageTy, typename RIDTableTy, template <typename _ElemTy, typename > class PageContTy>
+#define PAGEDB_TRANSPOSER pagedb_transposer<PageTy, RIDTableTy, PageContTy>
+
+PAGEDB_TRANSPOSER_TEMPLATE
+PAGEDB_TRANSPOSER::pagedb_transposer(___size_t num_threads_, ___size_t buckets_per_thread_) :
+	num_threads{ (num_threads_ > 0) ? num_threads_ : std::max<___size_t>(1, std::thread::hardware_concurrency()) },
+	buckets_per_thread{ (buckets_per_thread_ > 0) ? buckets_per_thread_ : 1 },
+	pages_per_bucket{ 1 }
+{
+}
+
+PAGEDB_TRANSPOSER_TEMPLATE
+template <typename FnTy>
+void PAGEDB_TRANSPOSER::parallel_for(___size_t count, FnTy fn)
+{
+	const ___size_t num_workers = std::min(num_threads, std::max<___size_t>(1, count));
+	const ___size_t chunk = (count + num_workers - 1) / num_workers;
+	std::vector<std::thread> workers;
+	for (___size_t w = 1; w < num_workers; ++w)
+		workers.emplace_back(fn, w, std::min(count, w * chunk), std::min(count, (w + 1) * chunk));
+	fn(0, 0, std::min(count, chunk));
+	for (auto& worker : workers)
+		worker.join();
+}
+
+PAGEDB_TRANSPOSER_TEMPLATE
+template <typename FnTy>
+void PAGEDB_TRANSPOSER::for_each_edge(page_cont_t& pages, page_cont_t& overflow_pages, const rid_table_t& rid_table, ___size_t pid, FnTy fn) const
+{
+	page_t& page = pages[pid];
+	if (page.is_lp_extended()) {
+		const page_id_t head = static_cast<page_id_t>(pid - static_cast<___size_t>(rid_table[pid].auxiliary));
+		const adj_list_elem_t* list = page.list_ext(0);
+		const ___size_t n = page.footer.front / sizeof(adj_list_elem_t);
+		for (___size_t i = 0; i < n; ++i)
+			fn(head, slot_offset_t{ 0 }, list[i]);
+		return;
+	}
+	if (page.is_lp_head()) {
+		const adj_list_elem_t* list = page.list(0);
+		const ___size_t n = (page.footer.front - sizeof(record_size_t)) / sizeof(adj_list_elem_t);
+		for (___size_t i = 0; i < n; ++i)
+			fn(static_cast<page_id_t>(pid), slot_offset_t{ 0 }, list[i]);
+	}
+	else {
+		for (offset_t s = 0; s < page.number_of_slots(); ++s) {
+			const adj_list_elem_t* list = page.list(s);
+			const ___size_t n = page.record_size(s);
+			for (___size_t i = 0; i < n; ++i)
+				fn(static_cast<page_id_t>(pid), static_cast<slot_offset_t>(s), list[i]);
+		}
+	}
+	// Spilled lists of this page; the slots of overflow pages carry the vertex id of the owner
+	const vertex_id_t start_vid = rid_table[pid].start_vid;
+	for (uint32_t link = page.overflow_link(); link != 0; link = overflow_pages[link - 1].overflow_link()) {
+		page_t& overflow_page = overflow_pages[link - 1];
+		for (offset_t s = 0; s < overflow_page.number_of_slots(); ++s) {
+			const slot_offset_t src_slot = static_cast<slot_offset_t>(overflow_page.slot(s).vertex_id - start_vid);
+			const adj_list_elem_t* list = overflow_page.list(s);
+			const ___size_t n = overflow_page.record_size(s);
+			for (___size_t i = 0; i < n; ++i)
+				fn(static_cast<page_id_t>(pid), src_slot, list[i]);
+		}
+	}
+}
+
+PAGEDB_TRANSPOSER_TEMPLATE
+typename PAGEDB_TRANSPOSER::transpose_result PAGEDB_TRANSPOSER::transpose(page_cont_t& pages, page_cont_t& overflow_pages, const rid_table_t& rid_table, page_cont_t& in_pages, page_cont_t& in_overflow_pages)
+{
+	transpose_result result{ generator_error_t::success, 0, 0, 0 };
+	if (pages.size() == 0 || rid_table.size() != pages.size()) {
+		result.error = generator_error_t::init_failed_empty_pagedb;
+		return result;
+	}
+	if (has_elided_vertices(pages, rid_table)) {
+		result.error = generator_error_t::init_failed_elided_pagedb; // in-lists are bucketed by slot
+		return result;
+	}
+	const ___size_t num_pages = pages.size();
+	const ___size_t num_buckets = std::min(num_pages, num_threads * buckets_per_thread);
+	pages_per_bucket = (num_pages + num_buckets - 1) / num_buckets;
+	const ___size_t num_workers = std::min(num_threads, num_pages);
+
+	// (1) Count the reversed edges per (worker, bucket)
+	std::vector<___size_t> counts(num_workers * num_buckets, 0);
+	parallel_for(num_pages, [&](___size_t worker, ___size_t begin, ___size_t end) {
+		___size_t* count = &counts[worker * num_buckets];
+		for (___size_t pid = begin; pid < end; ++pid)
+			this->for_each_edge(pages, overflow_pages, rid_table, pid, [&](page_id_t, slot_offset_t, const adj_list_elem_t& elem) {
+				++count[this->bucket_of(elem.page_id)];
+			});
+	});
+
+	// (2) Scatter into private ranges of the buckets
+	std::vector<bucket_t> buckets(num_buckets);
+	std::vector<___size_t> offsets(num_workers * num_buckets, 0);
+	for (___size_t b = 0; b < num_buckets; ++b) {
+		___size_t size = 0;
+		for (___size_t w = 0; w < num_workers; ++w) {
+			offsets[w * num_buckets + b] = size;
+			size += counts[w * num_buckets + b];
+		}
+		buckets[b].records.resize(size);
+		buckets[b].num_spilled = 0;
+		result.num_edges += size;
+	}
+	parallel_for(num_pages, [&](___size_t worker, ___size_t begin, ___size_t end) {
+		___size_t* offset = &offsets[worker * num_buckets];
+		for (___size_t pid = begin; pid < end; ++pid)
+			this->for_each_edge(pages, overflow_pages, rid_table, pid, [&](page_id_t src_page, slot_offset_t src_slot, const adj_list_elem_t& elem) {
+				const ___size_t b = this->bucket_of(elem.page_id);
+				in_record& record = buckets[b].records[offset[b]++];
+				record.dst_page = elem.page_id;
+				record.dst_slot = elem.slot_offset;
+				record.elem = elem;
+				record.elem.page_id = src_page;
+				record.elem.slot_offset = src_slot;
+			});
+	});
+
+	// (3) Sort and build the buckets
+	in_pages.clear();
+	in_pages.resize(num_pages);
+	parallel_for(num_buckets, [&](___size_t, ___size_t begin, ___size_t end) {
+		for (___size_t b = begin; b < end; ++b)
+			this->build_bucket(buckets[b], pages, rid_table, in_pages, b * pages_per_bucket, std::min(num_pages, (b + 1) * pages_per_bucket));
+	});
+
+	// Concatenate the overflow pages and make their links global; every link, local or global, is at most the total
+	in_overflow_pages.clear();
+	___size_t num_overflow_pages = 0;
+	for (const bucket_t& bucket : buckets)
+		num_overflow_pages += bucket.overflow_pages.size();
+	if (num_overflow_pages > max_overflow_link()) {
+		in_pages.clear();
+		result.error = generator_error_t::failed_field_overflow;
+		return result;
+	}
+	for (___size_t b = 0; b < num_buckets; ++b) {
+		const uint32_t base = static_cast<uint32_t>(in_overflow_pages.size());
+		const ___size_t last_page = std::min(num_pages, (b + 1) * pages_per_bucket);
+		for (___size_t pid = b * pages_per_bucket; pid < last_page; ++pid)
+			if (in_pages[pid].overflow_link() != 0)
+				in_pages[pid].overflow_link() += base;
+		for (page_t& page : buckets[b].overflow_pages) {
+			if (page.overflow_link() != 0)
+				page.overflow_link() += base;
+			in_overflow_pages.push_back(page);
+		}
+		result.num_spilled += buckets[b].num_spilled;
+		std::vector<page_t>().swap(buckets[b].overflow_pages);
+	}
+	result.num_overflow_pages = in_overflow_pages.size();
+	return result;
+}
+
+PAGEDB_TRANSPOSER_TEMPLATE
+void PAGEDB_TRANSPOSER::build_bucket(bucket_t& bucket, page_cont_t& pages, const rid_table_t& rid_table, page_cont_t& in_pages, ___size_t first_page, ___size_t last_page)
+{
+	std::vector<in_record>& records = bucket.records;
+	// Source order inside a list: (page, slot) order is vertex id order. The records are in forward page order
+	// after the scatter, so a stable sort makes the result independent of the number of threads.
+	std::stable_sort(records.begin(), records.end(), [](const in_record& lhs, const in_record& rhs) {
+		if (lhs.dst_page != rhs.dst_page)
+			return lhs.dst_page < rhs.dst_page;
+		if (lhs.dst_slot != rhs.dst_slot)
+			return lhs.dst_slot < rhs.dst_slot;
+		if (lhs.elem.page_id != rhs.elem.page_id)
+			return lhs.elem.page_id < rhs.elem.page_id;
+		return lhs.elem.slot_offset < rhs.elem.slot_offset;
+	});
+
+	std::unique_ptr<builder_t> builder{ new builder_t() };
+	std::vector<adj_list_elem_t> buffer;
+	auto it = records.begin();
+	for (___size_t pid = first_page; pid < last_page; ++pid) {
+		page_t& page = pages[pid];
+		if (page.is_lp_extended())
+			continue; // built together with the head page (possibly by the previous bucket)
+
+		if (page.is_lp_head()) {
+			buffer.clear();
+			for (; it != records.end() && it->dst_page == pid; ++it)
+				buffer.push_back(it->elem);
+			const ___size_t num_ext = static_cast<___size_t>(rid_table[pid].auxiliary);
+			___size_t stored = std::min(buffer.size(), max_record_size());
+			stored = std::min(stored, MaximumEdgesInHeadPage + num_ext * MaximumEdgesInExtPage);
+			___size_t in_page = stored;
+			if (in_page > MaximumEdgesInHeadPage)
+				in_page = MaximumEdgesInHeadPage;
+
+			builder->reset();
+			builder->add_dummy_slot();
+			builder->slot(0) = page.slot(0);
+			builder->slot(0).record_offset = 0;
+			builder->add_list_lp_head(stored, buffer.data(), in_page);
+			builder->flags() = slotted_page_flag::LP_HEAD;
+			builder->footer.reserved = 0;
+			memcpy(static_cast<void*>(&in_pages[pid]), builder.get(), PageSize);
+
+			___size_t offset = in_page;
+			for (___size_t ext = 1; ext <= num_ext; ++ext) {
+				in_page = stored - offset;
+				if (in_page > MaximumEdgesInExtPage)
+					in_page = MaximumEdgesInExtPage;
+				builder->reset();
+				builder->add_dummy_slot_ext();
+				builder->slot(0) = page.slot(0);
+				builder->slot(0).record_offset = 0;
+				builder->add_list_lp_ext(buffer.data() + offset, in_page);
+				builder->flags() = slotted_page_flag::LP_EXTENDED;
+				builder->footer.reserved = 0;
+				memcpy(static_cast<void*>(&in_pages[pid + ext]), builder.get(), PageSize);
+				offset += in_page;
+			}
+			if (stored < buffer.size())
+				spill(bucket, in_pages[pid], page.slot(0), buffer.data() + stored, buffer.size() - stored);
+			continue;
+		}
+
+		// Small page: every slot is kept; the free space is shared in slot order
+		const offset_t num_slots = page.number_of_slots();
+		___size_t used = num_slots * (sizeof(slot_t) + sizeof(record_size_t));
+		std::vector<std::pair<___size_t, ___size_t>> spilled; // (first record, count) per slot
+		builder->reset();
+		for (offset_t s = 0; s < num_slots; ++s) {
+			buffer.clear();
+			for (; it != records.end() && it->dst_page == pid && it->dst_slot == s; ++it)
+				buffer.push_back(it->elem);
+			___size_t stored = std::min(buffer.size(), max_record_size());
+			stored = std::min(stored, (DataSectionSize - used) / sizeof(adj_list_elem_t));
+			used += stored * sizeof(adj_list_elem_t);
+
+			auto record_offset = builder->footer.front;
+			offset_t offset = builder->add_dummy_slot();
+			slot_t& slot = builder->slot(offset);
+			slot = page.slot(s);
+			slot.record_offset = static_cast<record_offset_t>(record_offset);
+			builder->add_list_sp(offset, buffer.data(), stored);
+			if (stored < buffer.size())
+				spilled.push_back(std::make_pair(static_cast<___size_t>(it - records.begin()) - (buffer.size() - stored), buffer.size() - stored));
+		}
+		builder->flags() = slotted_page_flag::SP;
+		builder->footer.reserved = 0;
+		memcpy(static_cast<void*>(&in_pages[pid]), builder.get(), PageSize);
+		for (auto& range : spilled) {
+			const in_record& first = records[range.first];
+			buffer.clear();
+			for (___size_t i = 0; i < range.second; ++i)
+				buffer.push_back(records[range.first + i].elem);
+			spill(bucket, in_pages[pid], page.slot(static_cast<offset_t>(first.dst_slot)), buffer.data(), buffer.size());
+		}
+	}
+	std::vector<in_record>().swap(records);
+}
+
+PAGEDB_TRANSPOSER_TEMPLATE
+void PAGEDB_TRANSPOSER::spill(bucket_t& bucket, page_t& owner, const slot_t& owner_slot, const adj_list_elem_t* elems, ___size_t count)
+{
+	bucket.num_spilled += count;
+	// Find the last page of the (local) overflow chain of the owner
+	___size_t last = 0;
+	for (uint32_t link = owner.overflow_link(); link != 0; link = bucket.overflow_pages[link - 1].overflow_link())
+		last = link;
+
+	while (count > 0) {
+		if (last != 0) {
+			builder_t& builder = builder_of(bucket.overflow_pages[last - 1]);
+			auto scan_result = builder.scan();
+			___size_t capacity = std::min(scan_result.second, max_record_size());
+			if (scan_result.first && capacity > 0) {
+				___size_t num_elems = std::min(count, capacity);
+				auto record_offset = builder.footer.front;
+				offset_t offset = builder.add_dummy_slot();
+				slot_t& slot = builder.slot(offset);
+				slot = owner_slot;
+				slot.record_offset = static_cast<record_offset_t>(record_offset);
+				builder.add_list_sp(offset, const_cast<adj_list_elem_t*>(elems), num_elems);
+				elems += num_elems;
+				count -= num_elems;
+				continue;
+			}
+		}
+		bucket.overflow_pages.resize(bucket.overflow_pages.size() + 1);
+		bucket.overflow_pages.back().flags() = slotted_page_flag::SP | slotted_page_flag::OVERFLOW_PAGE;
+		// Checked by transpose() against the size of the concatenated store, which bounds every local link
+		uint32_t link = static_cast<uint32_t>(bucket.overflow_pages.size());
+		if (last == 0)
+			owner.overflow_link() = link;
+		else
+			bucket.overflow_pages[last - 1].overflow_link() = link;
+		last = link;
+	}
+}
+
+#undef PAGEDB_TRANSPOSER
+#undef PAGEDB_TRANSPOSER_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGEDB_TRANSPOSE_H_
@@ -0,0 +1,512 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		pagedb_update.h
+*	@brief		Incremental edge insertion/deletion on an existing PageDB
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_PAGEDB_UPDATE_H_
+#define _GSTREAM_DATATYPE_PAGEDB_UPDATE_H_
+
+#include <gstream/datatype/pagedb.h>
+#include <algorithm>
+#include <limits>
+
+/* ---------------------------------------------------------------
+**
+** Incremental update model
+**
+** - Vertex locations (page_id, slot_offset) never move, so adjacency
+**   elements of untouched pages stay valid.
+** - An updated small page is repacked in place as long as its slots
+**   and lists fit in the data section. Inserted elements which do not
+**   fit are spilled to the overflow store.
+** - Large pages append to the free space of the last extended page of
+**   the chain, and spill to the overflow store when it is full.
+** - The overflow store is a separate container of SP-formatted pages
+**   (flag: OVERFLOW_PAGE). A base page links its first overflow page
+**   with overflow_link() (= 1 + index in the store); overflow pages
+**   are chained the same way. A slot of an overflow page carries the
+**   vertex_id of the owner vertex. record_size of a base slot counts
+**   the elements stored in the base page (chain) only.
+** - New vertices (vertex_id > current maximum) are appended to the
+**   last small page and to new small pages; the RID table is patched
+**   with a tuple per new page.
+** - Updated base pages are marked with the TOUCHED flag for a later
+**   compaction (see pagedb_compaction.h).
+** - A new page id must fit in page_id_t and an overflow link in 32
+**   bits. Otherwise update() fails with failed_field_overflow:
+**   the new vertices are taken back if their pages are the cause,
+**   the pages updated before the failing one keep their updates and
+**   the failing page and the rest of the batch are left untouched.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+template <typename PageTy,
+	typename RIDTableTy = typename generator_traits<PageTy>::rid_table_t,
+	template <typename _ElemTy,
+	typename = std::allocator<_ElemTy> >
+	class PageContTy = std::vector >
+class pagedb_updater {
+public:
+	using page_t = PageTy;
+	using traits_t = page_traits<page_t>;
+	using builder_t = typename traits_t::page_builder_t;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(builder_t);
+	ALIAS_SLOTTED_PAGE_TEMPLATE_CONSTDEFS(builder_t);
+	using rid_table_t = RIDTableTy;
+	using rid_tuple_t = typename rid_table_t::value_type;
+	using page_cont_t = PageContTy<page_t>;
+	using edge_t = typename traits_t::edge_t;
+	using vertex_t = typename traits_t::vertex_t;
+
+	struct update_result {
+		generator_error_t error;
+		___size_t num_inserted;     // inserted into base pages
+		___size_t num_spilled;      // inserted into the overflow store
+		___size_t num_deleted;
+		___size_t num_not_found;    // deletions without a matching edge
+		___size_t num_rejected;     // edges referring a vertex before the first vertex of the PageDB
+		___size_t num_new_vertices;
+	};
+
+	// Precondition: the PageDB is not empty (generated by pagedb_generator)
+	pagedb_updater(page_cont_t& pages_, page_cont_t& overflow_pages_, rid_table_t& rid_table_, const vertex_t& default_vertex_ = vertex_t{});
+
+	/// Update: apply a batch of edge deletions and then a batch of edge insertions;
+	// init_failed_elided_pagedb (and nothing is applied) if the PageDB was generated with zero-degree elision,
+	// failed_field_overflow if a new page id or overflow link does not fit (see above for what is applied)
+	update_result update(const edge_t* inserted, ___size_t num_inserted, const edge_t* deleted, ___size_t num_deleted);
+
+	/// Pages marked by updates (candidates for compaction)
+	std::vector<page_id_t> touched_pages() const;
+	void clear_touched();
+	vertex_id_t max_vertex_id() const;
+
+protected:
+	struct operation {
+		vertex_id_t     src;
+		bool            insert;
+		adj_list_elem_t elem;
+	};
+	using list_t = std::vector<adj_list_elem_t>;
+	static inline ___size_t max_record_size()
+	{
+		return static_cast<___size_t>(std::numeric_limits<record_size_t>::max());
+	}
+	static inline ___size_t max_page_id()
+	{
+		return static_cast<___size_t>(std::numeric_limits<page_id_t>::max());
+	}
+	static inline ___size_t max_overflow_link()
+	{
+		return static_cast<___size_t>(std::numeric_limits<uint32_t>::max());
+	}
+	// Every new overflow page takes at least one element, so 'count' links always suffice
+	inline bool can_spill(___size_t count) const
+	{
+		return count <= max_overflow_link() - overflow_pages.size();
+	}
+	static inline ___size_t number_of_insertions(const operation* first, const operation* last)
+	{
+		___size_t count = 0;
+		for (const operation* op = first; op != last; ++op)
+			count += op->insert ? 1 : 0;
+		return count;
+	}
+
+	static inline builder_t& builder_of(page_t& page)
+	{
+		return reinterpret_cast<builder_t&>(page);
+	}
+	static inline bool same_target(const adj_list_elem_t& lhs, const adj_list_elem_t& rhs)
+	{
+		return lhs.page_id == rhs.page_id && lhs.slot_offset == rhs.slot_offset;
+	}
+	static bool erase_elem(list_t& list, const adj_list_elem_t& elem);
+
+	bool append_vertices(vertex_id_t last_vid, update_result& result);
+	bool make_operation(const edge_t& edge, bool insert, operation& out) const;
+	bool update_sp(page_id_t pid, const operation* first, const operation* last, update_result& result);
+	bool update_lp(page_id_t pid, const operation* first, const operation* last, update_result& result);
+	void decode(page_t& page, std::vector<list_t>& lists) const;
+	void repack(page_t& page, const std::vector<list_t>& lists);
+	bool spill(page_id_t owner, const slot_t& owner_slot, const adj_list_elem_t* elems, ___size_t count);
+	bool erase_from_overflow(page_id_t owner, vertex_id_t vid, const adj_list_elem_t& elem);
+
+	page_cont_t& pages;
+	page_cont_t& overflow_pages;
+	rid_table_t& rid_table;
+	vertex_t     default_vertex;
+	bool         elided; // the PageDB has zero-degree elision; updates never produce it
+	std::unique_ptr<builder_t> scratch{ new builder_t() };
+};
+
+#define PAGEDB_UPDATER_TEMPLATE template <typename PageTy, typename RIDTableTy, template <typename _ElemTy, typename > class PageContTy>
+#define PAGEDB_UPDATER pagedb_updater<PageTy, RIDTableTy, PageContTy>
+
+PAGEDB_UPDATER_TEMPLATE
+PAGEDB_UPDATER::pagedb_updater(page_cont_t& pages_, page_cont_t& overflow_pages_, rid_table_t& rid_table_, const vertex_t& default_vertex_) :
+	pages{ pages_ },
+	overflow_pages{ overflow_pages_ },
+	rid_table{ rid_table_ },
+	default_vertex(default_vertex_),
+	elided{ has_elided_vertices(pages_, rid_table_) }
+{
+}
+
+PAGEDB_UPDATER_TEMPLATE
+typename PAGEDB_UPDATER::vertex_id_t PAGEDB_UPDATER::max_vertex_id() const
+{
+	const rid_tuple_t& tuple = rid_table.back();
+	const page_t& page = pages[rid_table.size() - 1];
+	if (page.is_lp())
+		return tuple.start_vid;
+	return static_cast<vertex_id_t>(tuple.start_vid + page.number_of_slots() - 1);
+}
+
+PAGEDB_UPDATER_TEMPLATE
+std::vector<typename PAGEDB_UPDATER::page_id_t> PAGEDB_UPDATER::touched_pages() const
+{
+	std::vector<page_id_t> touched;
+	for (___size_t i = 0; i < pages.size(); ++i) {
+		if (pages[i].is_touched())
+			touched.push_back(static_cast<page_id_t>(i));
+	}
+	return touched;
+}
+
+PAGEDB_UPDATER_TEMPLATE
+void PAGEDB_UPDATER::clear_touched()
+{
+	for (auto& page : pages)
+		page.flags() &= ~slotted_page_flag::TOUCHED;
+}
+
+PAGEDB_UPDATER_TEMPLATE
+typename PAGEDB_UPDATER::update_result PAGEDB_UPDATER::update(const edge_t* inserted, ___size_t num_inserted, const edge_t* deleted, ___size_t num_deleted)
+{
+	update_result result{ generator_error_t::success, 0, 0, 0, 0, 0, 0 };
+	if (elided) {
+		result.error = generator_error_t::init_failed_elided_pagedb;
+		return result;
+	}
+
+	// Append new vertices first, so that every inserted edge can be translated into an adjacency element
+	vertex_id_t new_max_vid = max_vertex_id();
+	for (___size_t i = 0; i < num_inserted; ++i) {
+		new_max_vid = std::max(new_max_vid, inserted[i].src);
+		new_max_vid = std::max(new_max_vid, inserted[i].dst);
+	}
+	if (new_max_vid > max_vertex_id() && !append_vertices(new_max_vid, result)) {
+		result.error = generator_error_t::failed_field_overflow;
+		return result;
+	}
+
+	std::vector<operation> operations;
+	operations.reserve(num_inserted + num_deleted);
+	operation op;
+	for (___size_t i = 0; i < num_deleted; ++i) {
+		if (make_operation(deleted[i], false, op))
+			operations.push_back(op);
+		else
+			++result.num_not_found;
+	}
+	for (___size_t i = 0; i < num_inserted; ++i) {
+		if (make_operation(inserted[i], true, op))
+			operations.push_back(op);
+		else
+			++result.num_rejected;
+	}
+	// Deletions of a vertex are applied before its insertions
+	std::stable_sort(operations.begin(), operations.end(), [](const operation& lhs, const operation& rhs) { return lhs.src < rhs.src; });
+
+	// Process the operations page by page
+	___size_t off = 0;
+	while (off < operations.size()) {
+		page_id_t pid = find_vertex_page<builder_t>(operations[off].src, rid_table).first;
+		___size_t end = off + 1;
+		while (end < operations.size() && find_vertex_page<builder_t>(operations[end].src, rid_table).first == pid)
+			++end;
+		const bool updated = pages[pid].is_lp() ?
+			update_lp(pid, operations.data() + off, operations.data() + end, result) :
+			update_sp(pid, operations.data() + off, operations.data() + end, result);
+		if (!updated) {
+			result.error = generator_error_t::failed_field_overflow;
+			return result;
+		}
+		off = end;
+	}
+	return result;
+}
+
+PAGEDB_UPDATER_TEMPLATE
+bool PAGEDB_UPDATER::make_operation(const edge_t& edge, bool insert, operation& out) const
+{
+	const vertex_id_t first_vid = rid_table.front().start_vid;
+	const vertex_id_t max_vid = max_vertex_id();
+	if (edge.src < first_vid || edge.dst < first_vid || edge.src > max_vid || edge.dst > max_vid)
+		return false;
+	auto location = find_vertex_page<builder_t>(edge.dst, rid_table);
+	out.src = edge.src;
+	out.insert = insert;
+	edge.template to_adj_elem<builder_t>(location.first, location.second, &out.elem);
+	return true;
+}
+
+// False if a new page id does not fit in page_id_t; the pages and the RID table are restored then
+PAGEDB_UPDATER_TEMPLATE
+bool PAGEDB_UPDATER::append_vertices(vertex_id_t last_vid, update_result& result)
+{
+	const ___size_t num_pages = pages.size();
+	const ___size_t num_tuples = rid_table.size();
+	memcpy(static_cast<void*>(scratch.get()), &pages.back(), PageSize); // the last page before the new slots
+
+	vertex_id_t vid = max_vertex_id();
+	while (vid < last_vid) {
+		++vid;
+		page_t* page = &pages.back();
+		if (!page->is_sp() || !builder_of(*page).scan().first) {
+			if (pages.size() > max_page_id()) {
+				pages.resize(num_pages);
+				memcpy(static_cast<void*>(&pages.back()), scratch.get(), PageSize);
+				while (rid_table.size() > num_tuples)
+					rid_table.pop_back();
+				result.num_new_vertices = 0;
+				return false;
+			}
+			// Issue a new small page and patch the RID table
+			pages.resize(pages.size() + 1);
+			page = &pages.back();
+			page->flags() = slotted_page_flag::SP;
+			rid_tuple_t tuple;
+			tuple.start_vid = vid;
+			tuple.auxiliary = 0; // small page: 0
+			rid_table.push_back(tuple);
+		}
+		vertex_t vertex = default_vertex;
+		vertex.vertex_id = vid;
+		vertex.to_slot(builder_of(*page));
+		++result.num_new_vertices;
+	}
+	return true;
+}
+
+PAGEDB_UPDATER_TEMPLATE
+bool PAGEDB_UPDATER::erase_elem(list_t& list, const adj_list_elem_t& elem)
+{
+	for (auto it = list.begin(); it != list.end(); ++it) {
+		if (same_target(*it, elem)) {
+			list.erase(it);
+			return true;
+		}
+	}
+	return false;
+}
+
+PAGEDB_UPDATER_TEMPLATE
+void PAGEDB_UPDATER::decode(page_t& page, std::vector<list_t>& lists) const
+{
+	offset_t num_slots = page.number_of_slots();
+	lists.resize(num_slots);
+	for (offset_t i = 0; i < num_slots; ++i) {
+		adj_list_elem_t* list = page.list(i);
+		lists[i].assign(list, list + page.record_size(i));
+	}
+}
+
+PAGEDB_UPDATER_TEMPLATE
+void PAGEDB_UPDATER::repack(page_t& page, const std::vector<list_t>& lists)
+{
+	builder_t& builder = *scratch;
+	builder.reset();
+	for (offset_t i = 0; i < static_cast<offset_t>(lists.size()); ++i) {
+		auto record_offset = builder.footer.front;
+		offset_t offset = builder.add_dummy_slot();
+		slot_t& slot = builder.slot(offset);
+		slot = page.slot(i);
+		slot.record_offset = static_cast<record_offset_t>(record_offset);
+		builder.add_list_sp(offset, const_cast<adj_list_elem_t*>(lists[i].data()), lists[i].size());
+	}
+	builder.footer.flags = page.footer.flags;
+	builder.footer.reserved = page.footer.reserved;
+	memcpy(static_cast<void*>(&page), &builder, PageSize);
+}
+
+PAGEDB_UPDATER_TEMPLATE
+bool PAGEDB_UPDATER::update_sp(page_id_t pid, const operation* first, const operation* last, update_result& result)
+{
+	// Only insertions spill; checked before anything is written
+	if (!can_spill(number_of_insertions(first, last)))
+		return false;
+
+	page_t& page = pages[pid];
+	const vertex_id_t start_vid = rid_table[pid].start_vid;
+	std::vector<list_t> lists;
+	decode(page, lists);
+	std::vector<___size_t> num_pending(lists.size(), 0); // inserted elements at the tail of each list
+
+	for (const operation* op = first; op != last; ++op) {
+		list_t& list = lists[op->src - start_vid];
+		if (op->insert) {
+			list.push_back(op->elem);
+			++num_pending[op->src - start_vid];
+		}
+		else if (erase_elem(list, op->elem) || erase_from_overflow(pid, op->src, op->elem))
+			++result.num_deleted;
+		else
+			++result.num_not_found;
+	}
+
+	// Move pending elements which do not fit in the page (or in a record) to the spill lists
+	___size_t used = lists.size() * (sizeof(slot_t) + sizeof(record_size_t));
+	for (auto& list : lists)
+		used += list.size() * sizeof(adj_list_elem_t);
+	std::vector<list_t> spilled(lists.size());
+	for (___size_t i = 0; i < lists.size(); ++i) {
+		while (num_pending[i] > 0 && (used > DataSectionSize || lists[i].size() > max_record_size())) {
+			spilled[i].push_back(lists[i].back());
+			lists[i].pop_back();
+			used -= sizeof(adj_list_elem_t);
+			--num_pending[i];
+		}
+		result.num_inserted += num_pending[i];
+	}
+
+	page.flags() |= slotted_page_flag::TOUCHED;
+	repack(page, lists);
+
+	for (___size_t i = 0; i < spilled.size(); ++i) {
+		if (spilled[i].empty())
+			continue;
+		std::reverse(spilled[i].begin(), spilled[i].end()); // keep the insertion order
+		if (!spill(pid, page.slot(static_cast<offset_t>(i)), spilled[i].data(), spilled[i].size()))
+			return false;
+		result.num_spilled += spilled[i].size();
+	}
+	return true;
+}
+
+PAGEDB_UPDATER_TEMPLATE
+bool PAGEDB_UPDATER::update_lp(page_id_t pid, const operation* first, const operation* last, update_result& result)
+{
+	page_t& head = pages[pid];
+	const ___size_t last_pid = pid + static_cast<___size_t>(rid_table[pid].auxiliary);
+	record_size_t& record_size = head.record_size(0);
+	if (!can_spill(number_of_insertions(first, last)))
+		return false;
+
+	for (const operation* op = first; op != last; ++op) {
+		if (op->insert) {
+			page_t& tail = pages[last_pid];
+			if ((tail.footer.rear - tail.footer.front) >= sizeof(adj_list_elem_t) && record_size < max_record_size()) {
+				memcpy(&tail.data_section[tail.footer.front], &op->elem, sizeof(adj_list_elem_t));
+				tail.footer.front += static_cast<offset_t>(sizeof(adj_list_elem_t));
+				record_size += 1;
+				++result.num_inserted;
+			}
+			else {
+				if (!spill(pid, head.slot(0), &op->elem, 1))
+					return false;
+				++result.num_spilled;
+			}
+			continue;
+		}
+
+		// Deletion: search the head and the extended pages, then the overflow store
+		bool found = false;
+		for (___size_t i = pid; i <= last_pid && !found; ++i) {
+			page_t& page = pages[i];
+			adj_list_elem_t* list = (i == pid) ? page.list(0) : page.list_ext(0);
+			uint8_t* end = &page.data_section[page.footer.front];
+			for (adj_list_elem_t* elem = list; reinterpret_cast<uint8_t*>(elem) < end; ++elem) {
+				if (!same_target(*elem, op->elem))
+					continue;
+				memmove(elem, elem + 1, end - reinterpret_cast<uint8_t*>(elem + 1));
+				page.footer.front -= static_cast<offset_t>(sizeof(adj_list_elem_t));
+				memset(&page.data_section[page.footer.front], 0, sizeof(adj_list_elem_t));
+				record_size -= 1;
+				found = true;
+				break;
+			}
+		}
+		if (found || erase_from_overflow(pid, op->src, op->elem))
+			++result.num_deleted;
+		else
+			++result.num_not_found;
+	}
+	head.flags() |= slotted_page_flag::TOUCHED;
+	return true;
+}
+
+// False if a new overflow link does not fit in 32 bits
+PAGEDB_UPDATER_TEMPLATE
+bool PAGEDB_UPDATER::spill(page_id_t owner, const slot_t& owner_slot, const adj_list_elem_t* elems, ___size_t count)
+{
+	// Find the last page of the overflow chain
+	___size_t last = 0; // (1 + index) of the last overflow page, 0: the chain is empty
+	for (uint32_t link = pages[owner].overflow_link(); link != 0; link = overflow_pages[link - 1].overflow_link())
+		last = link;
+
+	while (count > 0) {
+		if (last != 0) {
+			builder_t& builder = builder_of(overflow_pages[last - 1]);
+			auto scan_result = builder.scan();
+			___size_t capacity = std::min(scan_result.second, max_record_size());
+			if (scan_result.first && capacity > 0) {
+				___size_t num_elems = std::min(count, capacity);
+				auto record_offset = builder.footer.front;
+				offset_t offset = builder.add_dummy_slot();
+				slot_t& slot = builder.slot(offset);
+				slot = owner_slot;
+				slot.record_offset = static_cast<record_offset_t>(record_offset);
+				builder.add_list_sp(offset, const_cast<adj_list_elem_t*>(elems), num_elems);
+				elems += num_elems;
+				count -= num_elems;
+				continue;
+			}
+		}
+		// Allocate a new overflow page and link it to the chain
+		if (overflow_pages.size() >= max_overflow_link())
+			return false;
+		overflow_pages.resize(overflow_pages.size() + 1);
+		overflow_pages.back().flags() = slotted_page_flag::SP | slotted_page_flag::OVERFLOW_PAGE;
+		uint32_t link = static_cast<uint32_t>(overflow_pages.size());
+		if (last == 0)
+			pages[owner].overflow_link() = link;
+		else
+			overflow_pages[last - 1].overflow_link() = link;
+		last = link;
+	}
+	return true;
+}
+
+PAGEDB_UPDATER_TEMPLATE
+bool PAGEDB_UPDATER::erase_from_overflow(page_id_t owner, vertex_id_t vid, const adj_list_elem_t& elem)
+{
+	std::vector<list_t> lists;
+	for (uint32_t link = pages[owner].overflow_link(); link != 0; link = overflow_pages[link - 1].overflow_link()) {
+		page_t& page = overflow_pages[link - 1];
+		for (offset_t i = 0; i < page.number_of_slots(); ++i) {
+			if (page.slot(i).vertex_id != vid)
+				continue;
+			decode(page, lists);
+			if (erase_elem(lists[i], elem)) {
+				repack(page, lists);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+#undef PAGEDB_UPDATER
+#undef PAGEDB_UPDATER_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_PAGEDB_UPDATE_H_
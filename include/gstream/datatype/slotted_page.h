@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <type_traits>
 #include <memory>
+#include <algorithm>
+#include <utility>
 #include <gstream/mpl.h>
 
 /* ---------------------------------------------------------------
@@ -109,6 +111,9 @@ constexpr uint32_t _BASE = 0x0001;
 constexpr uint32_t SP = _BASE;
 constexpr uint32_t LP_HEAD = _BASE << 1;
 constexpr uint32_t LP_EXTENDED = _BASE << 2;
+constexpr uint32_t OVERFLOW_PAGE = _BASE << 3; // page of an overflow store, holds spilled adjacency lists (incremental update)
+constexpr uint32_t TOUCHED = _BASE << 4; // page was modified by an incremental update (candidate for compaction)
+constexpr uint32_t ELIDED_VERTICES = _BASE << 5; // small page whose vertex range has vertices without a slot (zero-degree elision, pagedb.h)
 } // !namespace slotted_page_flag
 
 namespace _slotted_page {
@@ -276,6 +281,32 @@ public:
     {
         return *reinterpret_cast<slot_t*>(&this->data_section[DataSectionSize - (sizeof(slot_t) * (offset + 1))]);
     }
+    inline const slot_t& slot(const offset_t offset) const
+    {
+        return *reinterpret_cast<const slot_t*>(&this->data_section[DataSectionSize - (sizeof(slot_t) * (offset + 1))]);
+    }
+    /// Slot of: the slot of the vertex at 'vertex_offset' in the vertex range of a small page, number_of_slots() if it has none.
+    // A page with elided vertices keeps the slots of its first vertex and of its vertices with edges, in vertex id order.
+    inline offset_t slot_of(___size_t vertex_offset) const
+    {
+        const offset_t num_slots = number_of_slots();
+        if (0 == (footer.flags & slotted_page_flag::ELIDED_VERTICES))
+            return (vertex_offset < static_cast<___size_t>(num_slots)) ? static_cast<offset_t>(vertex_offset) : num_slots;
+        if (num_slots == 0)
+            return num_slots;
+        // The slot of a vertex is at most its offset in the range
+        const vertex_id_t vid = static_cast<vertex_id_t>(slot(0).vertex_id + vertex_offset);
+        offset_t lo = 0;
+        offset_t hi = (vertex_offset < static_cast<___size_t>(num_slots)) ? static_cast<offset_t>(vertex_offset + 1) : num_slots;
+        while (lo < hi) {
+            const offset_t mid = lo + (hi - lo) / 2;
+            if (slot(mid).vertex_id < vid)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return (lo < num_slots && slot(lo).vertex_id == vid) ? lo : num_slots;
+    }
     inline record_size_t& record_size(const slot_t& slot) 
     {
         return *reinterpret_cast<record_size_t*>(&data_section[slot.record_offset]);
@@ -321,6 +352,24 @@ public:
     {
         return 0 != (footer.flags & slotted_page_flag::SP);
     }
+    inline bool is_overflow() const
+    {
+        return 0 != (footer.flags & slotted_page_flag::OVERFLOW_PAGE);
+    }
+    inline bool is_touched() const
+    {
+        return 0 != (footer.flags & slotted_page_flag::TOUCHED);
+    }
+    inline bool has_elided_vertices() const
+    {
+        return 0 != (footer.flags & slotted_page_flag::ELIDED_VERTICES);
+    }
+    // Overflow link: (1 + index) of the first overflow page which holds spilled lists of this page, 0 if none.
+    // The link is stored in the reserved field of the footer.
+    inline uint32_t& overflow_link()
+    {
+        return footer.reserved;
+    }
     inline bool is_empty() const
     {
         return (footer.front == 0 && footer.rear == DataSectionSize);
@@ -480,6 +529,9 @@ public:
 
     /// Utilites
     void clear();
+    /// Reset: Same result as clear(), but zero-fills only the regions which have been used ([0, front) and [rear, DataSectionSize)).
+    // The free space between front and rear is never written by the builder, so it is still zero-filled.
+    void reset();
 };
 
 #define __GSTREAM_SLOTTED_PAGE_BUILDER slotted_page_builder<__GSTREAM_SLOTTED_PAGE_TEMPLATE_ARGS>
@@ -506,7 +558,7 @@ inline typename __GSTREAM_SLOTTED_PAGE_BUILDER::type& __GSTREAM_SLOTTED_PAGE_BUI
 __GSTREAM_SLOTTED_PAGE_TEMPLATE
 std::pair<bool/* (1) */, typename __GSTREAM_SLOTTED_PAGE_BUILDER::___size_t /* (2) */> __GSTREAM_SLOTTED_PAGE_BUILDER::scan() const
 {
-    auto free_space = this->footer.rear - this->footer.front;
+    auto free_space = static_cast<std::size_t>(this->footer.rear - this->footer.front); // narrow offset_t: promoted to int
     if (free_space < (sizeof(slot_t) + sizeof(record_size_t)))
         return std::make_pair(false, 0); // The page does not have enough space to store new slot.
     free_space -= (sizeof(slot_t) + sizeof(record_size_t));
@@ -516,7 +568,7 @@ std::pair<bool/* (1) */, typename __GSTREAM_SLOTTED_PAGE_BUILDER::___size_t /* (
 __GSTREAM_SLOTTED_PAGE_TEMPLATE
 std::pair<bool/* (1) */, typename __GSTREAM_SLOTTED_PAGE_BUILDER::___size_t /* (2) */> __GSTREAM_SLOTTED_PAGE_BUILDER::scan_ext() const
 {
-    auto free_space = this->footer.rear - this->footer.front;
+    auto free_space = static_cast<std::size_t>(this->footer.rear - this->footer.front); // narrow offset_t: promoted to int
     if (free_space < sizeof(slot_t)) //! Extended page does not need to space to store adjacency list size.
         return std::make_pair(false, 0); // The page does not have enough space to store new slot.
     free_space -= (sizeof(slot_t));
@@ -618,7 +670,7 @@ __GSTREAM_SLOTTED_PAGE_TEMPLATE
 void __GSTREAM_SLOTTED_PAGE_BUILDER::add_dummy_list_sp(const offset_t slot_offset, ___size_t record_size)
 {
     slot_t& slot = this->slot(slot_offset);
-    this->record_size(slot.record_offset) = static_cast<record_size_t>(record_size);
+    this->record_size(slot) = static_cast<record_size_t>(record_size);
     this->footer.front += static_cast<offset_t>(sizeof(adj_list_elem_t) * record_size);
 }
 
@@ -626,7 +678,7 @@ __GSTREAM_SLOTTED_PAGE_TEMPLATE
 void __GSTREAM_SLOTTED_PAGE_BUILDER::add_dummy_list_lp_head(___size_t record_size, ___size_t num_elems_in_page)
 {
     slot_t& slot = this->slot(0);
-    this->record_size(slot.record_offset) = record_size;
+    this->record_size(slot) = record_size;
     this->footer.front += sizeof(adj_list_elem_t) * num_elems_in_page;
 }
 
@@ -644,6 +696,15 @@ void __GSTREAM_SLOTTED_PAGE_BUILDER::clear()
     this->footer.rear = DataSectionSize;
 }
 
+__GSTREAM_SLOTTED_PAGE_TEMPLATE
+void __GSTREAM_SLOTTED_PAGE_BUILDER::reset()
+{
+    memset(this->data_section, 0, this->footer.front);
+    memset(&this->data_section[this->footer.rear], 0, DataSectionSize - this->footer.rear);
+    this->footer.front = 0;
+    this->footer.rear = DataSectionSize;
+}
+
 //#undef __GSTREAM_SLOTTED_PAGE_TEMPLATE_TYPEDEFS
 //#undef __GSTREAM_SLOTTED_PAGE_TEMPLATE_CONSTDEFS
 #undef __GSTREAM_SLOTTED_PAGE_BUILDER
@@ -672,6 +733,22 @@ typename __builder_t::slot_offset_t get_slot_offset(typename __builder_t::page_i
     return static_cast<typename __builder_t::slot_offset_t>(vid - tuple.start_vid);
 }
 
+/// Binary search version of vid_to_pid + get_slot_offset for a random-access RID table sorted by start_vid.
+// Returns the head page (slot 0) for a vertex stored in large pages. Precondition: table.front().start_vid <= vid
+template <typename __builder_t, typename __rid_table_t>
+std::pair<typename __builder_t::page_id_t, typename __builder_t::slot_offset_t> find_vertex_page(typename __builder_t::vertex_id_t vid, const __rid_table_t& table)
+{
+    using vertex_id_t = typename __builder_t::vertex_id_t;
+    using rid_tuple_t = typename __rid_table_t::value_type;
+    auto it = std::upper_bound(table.begin(), table.end(), vid, [](vertex_id_t v, const rid_tuple_t& tuple) { return v < tuple.start_vid; });
+    if (it != table.begin())
+        --it;
+    // Large pages share a start_vid; move to the first (head) page of the chain
+    auto head = std::lower_bound(table.begin(), it, it->start_vid, [](const rid_tuple_t& tuple, vertex_id_t v) { return tuple.start_vid < v; });
+    return std::make_pair(static_cast<typename __builder_t::page_id_t>(head - table.begin()),
+                          static_cast<typename __builder_t::slot_offset_t>(vid - head->start_vid));
+}
+
 template <typename __vertex_id_t, typename __payload_t = void>
 struct edge_template
 {
@@ -687,6 +764,13 @@ struct edge_template
         out->slot_offset = get_slot_offset<__builder_t>(out->page_id, dst, table);
         out->payload = payload;
     }
+    template <typename __builder_t>
+    void to_adj_elem(typename __builder_t::page_id_t page_id, typename __builder_t::slot_offset_t slot_offset, typename __builder_t::adj_list_elem_t* out) const
+    {
+        out->page_id = page_id;
+        out->slot_offset = slot_offset;
+        out->payload = payload;
+    }
 };
 
 template <typename __vertex_id_t>
@@ -702,6 +786,12 @@ struct edge_template<__vertex_id_t, void>
         out->page_id = vid_to_pid<__builder_t>(dst, table);
         out->slot_offset =  get_slot_offset<__builder_t>(out->page_id, dst, table);
     }
+    template <typename __builder_t>
+    void to_adj_elem(typename __builder_t::page_id_t page_id, typename __builder_t::slot_offset_t slot_offset, typename __builder_t::adj_list_elem_t* out) const
+    {
+        out->page_id = page_id;
+        out->slot_offset = slot_offset;
+    }
 };
 
 template <typename __vertex_id_t, typename __payload_t = void>
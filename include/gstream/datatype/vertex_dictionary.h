@@ -0,0 +1,470 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		vertex_dictionary.h
+*	@brief		Sparse (64-bit, hashed) external vertex id -> dense internal id dictionary
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_VERTEX_DICTIONARY_H_
+#define _GSTREAM_DATATYPE_VERTEX_DICTIONARY_H_
+
+#include <gstream/io/mapped_file.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** Vertex dictionary
+** The generators give a slot to every vertex id between the first
+** and the last one, so a sparse id space (e.g. 64-bit hashes) cannot
+** be packed as is. The dictionary maps the distinct external ids of
+** a graph to dense internal ids [0, n), which the generators take
+** instead; the pages and the generation time then scale with the
+** number of actual vertices.
+** Internal ids follow the ascending order of the external ids, so
+** any locality of the external ids is kept, and the result does not
+** depend on the number of threads.
+**
+**   gstream::vertex_dictionary<uint64_t, uint32_t> dict;
+**   dict.build(external_ids, n);                  // src and dst of every edge
+**   dict.translate(external_ids, n, internal_ids); // or translate_edges()
+**   ... generation over internal ids
+**   dict.write("graph.vdict");
+**
+** Build (parallel)
+** (1) Sample sort: every worker sorts and deduplicates a range of the
+**     input, the runs are split by sampled splitters and every worker
+**     merges one split: the concatenated splits are the reverse
+**     table (internal id -> external id)
+** (2) Hash table: the internal ids are scattered to buckets by the
+**     high bits of the hash of their external id; every bucket is an
+**     open-addressing table (linear probing, load <= 1/2) of its own
+**     region, filled by one worker, so no atomics are needed
+**
+** File layout (little endian, packed)
+**     header { magic "PGDBVDIC", external_id_size, internal_id_size,
+**              num_vertices, num_buckets, table_size }
+**     external_id[num_vertices]           (reverse lookup)
+**     bucket_offset[num_buckets + 1]      (uint64, region of bucket b)
+**     table[table_size]                   (internal id + 1, 0: empty)
+** open() maps the file read-only, like vertex_index.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+#pragma pack(push, 1)
+struct vertex_dictionary_header {
+	static constexpr std::uint64_t Magic = 0x4349445642444750ull; // "PGDBVDIC"
+	std::uint64_t magic;
+	std::uint32_t external_id_size;
+	std::uint32_t internal_id_size;
+	std::uint64_t num_vertices;
+	std::uint64_t num_buckets;
+	std::uint64_t table_size;
+};
+#pragma pack(pop)
+
+namespace _vertex_dictionary {
+
+// Payload copy of translate_edges()
+template <typename InEdgeTy, typename OutEdgeTy, typename PayloadTy = typename OutEdgeTy::payload_t>
+struct payload_copy {
+	static inline void copy(const InEdgeTy& in, OutEdgeTy& out)
+	{
+		out.payload = in.payload;
+	}
+};
+
+template <typename InEdgeTy, typename OutEdgeTy>
+struct payload_copy<InEdgeTy, OutEdgeTy, void> {
+	static inline void copy(const InEdgeTy&, OutEdgeTy&)
+	{
+	}
+};
+
+} // !namespace _vertex_dictionary
+
+template <typename ExternalIdTy = std::uint64_t, typename InternalIdTy = std::uint32_t>
+class vertex_dictionary {
+public:
+	using external_id_t = ExternalIdTy;
+	using internal_id_t = InternalIdTy;
+	static_assert(std::is_unsigned<internal_id_t>::value, "internal ids must be unsigned");
+	/// find(): the external id is not in the dictionary
+	static constexpr internal_id_t npos = std::numeric_limits<internal_id_t>::max();
+	/// Average number of vertices per bucket of the hash table
+	static constexpr std::size_t VerticesPerBucket = 1024;
+
+	vertex_dictionary() = default;
+	vertex_dictionary(const vertex_dictionary&) = delete;
+	vertex_dictionary& operator=(const vertex_dictionary&) = delete;
+
+	/// Build: the dictionary of the distinct ids of ids[0..n) (duplicates allowed);
+	// returns false if there are more distinct ids than internal ids (npos is reserved: at most npos ids)
+	// num_threads = 0: std::thread::hardware_concurrency()
+	bool build(const external_id_t* ids, std::size_t n, std::size_t num_threads = 0);
+	/// Build: from the src and dst of an edge set
+	template <typename EdgeTy>
+	bool build_from_edges(const EdgeTy* edges, std::size_t num_edges, std::size_t num_threads = 0);
+	void clear();
+
+	bool write(const char* filepath) const;
+	/// Open: map a dictionary file written by write(); the in-memory dictionary is released
+	bool open(const char* filepath);
+
+	/// Find: the internal id of an external id, npos if absent
+	internal_id_t find(external_id_t id) const;
+	inline bool contains(external_id_t id) const
+	{
+		return find(id) != npos;
+	}
+	inline internal_id_t operator[](external_id_t id) const
+	{
+		return find(id);
+	}
+	/// Reverse lookup: O(1); precondition: internal < size()
+	inline external_id_t external_id(internal_id_t internal) const
+	{
+		return ids_view[static_cast<std::size_t>(internal)];
+	}
+	inline std::size_t size() const
+	{
+		return num_vertices;
+	}
+
+	/// Translate: out[i] = find(ids[i]) (npos if absent)
+	void translate(const external_id_t* ids, std::size_t n, internal_id_t* out, std::size_t num_threads = 0) const;
+	/// Translate edges: src, dst (and payload) of in[i] into out[i], in the input order;
+	// sort the result by src before pagedb_generator. Precondition: every endpoint is in the dictionary
+	template <typename InEdgeTy, typename OutEdgeTy>
+	void translate_edges(const InEdgeTy* in, std::size_t n, OutEdgeTy* out, std::size_t num_threads = 0) const;
+
+protected:
+	static inline std::uint64_t hash(external_id_t id)
+	{
+		// splitmix64 finalizer: hashed ids stay uniform, sequential ids are spread
+		std::uint64_t x = static_cast<std::uint64_t>(id);
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+		return x ^ (x >> 31);
+	}
+	inline std::size_t bucket_of(std::uint64_t h) const
+	{
+		return static_cast<std::size_t>(h >> 32) & (num_buckets - 1);
+	}
+	static inline std::size_t resolve_threads(std::size_t num_threads)
+	{
+		return (num_threads > 0) ? num_threads : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+	}
+	// fn(worker, begin, end) over count items split into num_workers ranges
+	template <typename FnTy>
+	static void parallel_for(std::size_t num_workers, std::size_t count, FnTy fn);
+	void sort_unique(const external_id_t* ids, std::size_t n, std::size_t num_workers);
+	void build_table(std::size_t num_workers);
+	inline void sync_view()
+	{
+		ids_view = ids.data();
+		offsets_view = offsets.data();
+		table_view = table.data();
+		num_vertices = ids.size();
+		num_buckets = (offsets.size() > 0) ? offsets.size() - 1 : 0;
+	}
+
+	// In-memory dictionary (build)
+	std::vector<external_id_t> ids;     // by internal id, ascending
+	std::vector<std::uint64_t> offsets; // bucket regions
+	std::vector<internal_id_t> table;   // internal id + 1, 0: empty
+	// Mapped dictionary (open)
+	mapped_file file;
+
+	const external_id_t* ids_view{ nullptr };
+	const std::uint64_t* offsets_view{ nullptr };
+	const internal_id_t* table_view{ nullptr };
+	std::size_t          num_vertices{ 0 };
+	std::size_t          num_buckets{ 0 };
+};
+
+template <typename ExternalIdTy, typename InternalIdTy>
+constexpr InternalIdTy vertex_dictionary<ExternalIdTy, InternalIdTy>::npos;
+
+#define VERTEX_DICTIONARY_TEMPLATE template <typename ExternalIdTy, typename InternalIdTy>
+#define VERTEX_DICTIONARY vertex_dictionary<ExternalIdTy, InternalIdTy>
+
+VERTEX_DICTIONARY_TEMPLATE
+template <typename FnTy>
+void VERTEX_DICTIONARY::parallel_for(std::size_t num_workers, std::size_t count, FnTy fn)
+{
+	num_workers = std::min(num_workers, std::max<std::size_t>(1, count));
+	const std::size_t chunk = (count + num_workers - 1) / num_workers;
+	std::vector<std::thread> workers;
+	for (std::size_t w = 1; w < num_workers; ++w)
+		workers.emplace_back(fn, w, std::min(count, w * chunk), std::min(count, (w + 1) * chunk));
+	fn(0, 0, std::min(count, chunk));
+	for (auto& worker : workers)
+		worker.join();
+}
+
+VERTEX_DICTIONARY_TEMPLATE
+bool VERTEX_DICTIONARY::build(const external_id_t* input, std::size_t n, std::size_t num_threads)
+{
+	clear();
+	// Small inputs are not worth a thread
+	const std::size_t num_workers = std::max<std::size_t>(1, std::min(resolve_threads(num_threads), n / 4096));
+	sort_unique(input, n, num_workers);
+	if (ids.size() > static_cast<std::size_t>(npos)) {
+		clear();
+		return false;
+	}
+	build_table(num_workers);
+	sync_view();
+	return true;
+}
+
+VERTEX_DICTIONARY_TEMPLATE
+template <typename EdgeTy>
+bool VERTEX_DICTIONARY::build_from_edges(const EdgeTy* edges, std::size_t num_edges, std::size_t num_threads)
+{
+	std::vector<external_id_t> endpoints(num_edges * 2);
+	parallel_for(resolve_threads(num_threads), num_edges, [&](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			endpoints[2 * i] = static_cast<external_id_t>(edges[i].src);
+			endpoints[2 * i + 1] = static_cast<external_id_t>(edges[i].dst);
+		}
+	});
+	return build(endpoints.data(), endpoints.size(), num_threads);
+}
+
+VERTEX_DICTIONARY_TEMPLATE
+void VERTEX_DICTIONARY::sort_unique(const external_id_t* input, std::size_t n, std::size_t num_workers)
+{
+	if (num_workers == 1) {
+		ids.assign(input, input + n);
+		std::sort(ids.begin(), ids.end());
+		ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+		return;
+	}
+
+	// Sorted, deduplicated runs
+	std::vector<std::vector<external_id_t>> runs(num_workers);
+	parallel_for(num_workers, n, [&](std::size_t worker, std::size_t begin, std::size_t end) {
+		std::vector<external_id_t>& run = runs[worker];
+		run.assign(input + begin, input + end);
+		std::sort(run.begin(), run.end());
+		run.erase(std::unique(run.begin(), run.end()), run.end());
+	});
+
+	// Splitters from regular samples of the runs
+	constexpr std::size_t Oversampling = 8;
+	std::vector<external_id_t> samples;
+	for (const auto& run : runs)
+		for (std::size_t k = 1; k <= Oversampling * num_workers && !run.empty(); ++k)
+			samples.push_back(run[(run.size() - 1) * k / (Oversampling * num_workers)]);
+	std::sort(samples.begin(), samples.end());
+	std::vector<external_id_t> splitters(num_workers - 1);
+	for (std::size_t p = 0; p + 1 < num_workers; ++p)
+		splitters[p] = samples[samples.size() * (p + 1) / num_workers];
+
+	// Every worker merges one split: [splitters[p - 1], splitters[p]) of every run
+	std::vector<std::vector<external_id_t>> splits(num_workers);
+	parallel_for(num_workers, num_workers, [&](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t p = begin; p < end; ++p) {
+			std::vector<external_id_t>& split = splits[p];
+			for (const auto& run : runs) {
+				auto first = (p == 0) ? run.begin() : std::lower_bound(run.begin(), run.end(), splitters[p - 1]);
+				auto last = (p + 1 == num_workers) ? run.end() : std::lower_bound(run.begin(), run.end(), splitters[p]);
+				const std::size_t middle = split.size();
+				split.insert(split.end(), first, last);
+				std::inplace_merge(split.begin(), split.begin() + middle, split.end());
+			}
+			split.erase(std::unique(split.begin(), split.end()), split.end());
+		}
+	});
+	runs.clear();
+	runs.shrink_to_fit();
+
+	std::vector<std::size_t> bases(num_workers + 1, 0);
+	for (std::size_t p = 0; p < num_workers; ++p)
+		bases[p + 1] = bases[p] + splits[p].size();
+	ids.resize(bases[num_workers]);
+	parallel_for(num_workers, num_workers, [&](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t p = begin; p < end; ++p)
+			std::copy(splits[p].begin(), splits[p].end(), ids.begin() + bases[p]);
+	});
+}
+
+VERTEX_DICTIONARY_TEMPLATE
+void VERTEX_DICTIONARY::build_table(std::size_t num_workers)
+{
+	const std::size_t n = ids.size();
+	num_buckets = 1;
+	while (num_buckets * VerticesPerBucket < n)
+		num_buckets <<= 1;
+
+	// (1) Bucket sizes per worker range of internal ids
+	std::vector<std::size_t> counts(num_workers * num_buckets, 0);
+	parallel_for(num_workers, n, [&](std::size_t worker, std::size_t begin, std::size_t end) {
+		std::size_t* count = &counts[worker * num_buckets];
+		for (std::size_t i = begin; i < end; ++i)
+			++count[bucket_of(hash(ids[i]))];
+	});
+
+	// (2) Regions (power of two, at least twice the bucket size) and scatter cursors
+	offsets.assign(num_buckets + 1, 0);
+	std::vector<std::size_t> cursors(num_workers * num_buckets, 0);
+	std::vector<std::size_t> bucket_first(num_buckets + 1, 0);
+	for (std::size_t b = 0; b < num_buckets; ++b) {
+		std::size_t size = 0;
+		for (std::size_t w = 0; w < num_workers; ++w) {
+			cursors[w * num_buckets + b] = bucket_first[b] + size;
+			size += counts[w * num_buckets + b];
+		}
+		bucket_first[b + 1] = bucket_first[b] + size;
+		std::size_t capacity = (size > 0) ? 2 : 0;
+		while (capacity > 0 && capacity < 2 * size)
+			capacity <<= 1;
+		offsets[b + 1] = offsets[b] + capacity;
+	}
+	std::vector<internal_id_t> members(n);
+	parallel_for(num_workers, n, [&](std::size_t worker, std::size_t begin, std::size_t end) {
+		std::size_t* cursor = &cursors[worker * num_buckets];
+		for (std::size_t i = begin; i < end; ++i)
+			members[cursor[bucket_of(hash(ids[i]))]++] = static_cast<internal_id_t>(i);
+	});
+
+	// (3) Every bucket is filled by one worker
+	table.assign(static_cast<std::size_t>(offsets[num_buckets]), 0);
+	parallel_for(num_workers, num_buckets, [&](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t b = begin; b < end; ++b) {
+			internal_id_t* region = &table[static_cast<std::size_t>(offsets[b])];
+			const std::size_t mask = static_cast<std::size_t>(offsets[b + 1] - offsets[b]) - 1;
+			for (std::size_t m = bucket_first[b]; m < bucket_first[b + 1]; ++m) {
+				std::size_t slot = static_cast<std::size_t>(hash(ids[members[m]])) & mask;
+				while (region[slot] != 0)
+					slot = (slot + 1) & mask;
+				region[slot] = static_cast<internal_id_t>(members[m] + 1);
+			}
+		}
+	});
+}
+
+VERTEX_DICTIONARY_TEMPLATE
+void VERTEX_DICTIONARY::clear()
+{
+	file.close();
+	ids.clear();
+	offsets.clear();
+	table.clear();
+	ids_view = nullptr;
+	offsets_view = nullptr;
+	table_view = nullptr;
+	num_vertices = 0;
+	num_buckets = 0;
+}
+
+VERTEX_DICTIONARY_TEMPLATE
+typename VERTEX_DICTIONARY::internal_id_t VERTEX_DICTIONARY::find(external_id_t id) const
+{
+	if (num_vertices == 0)
+		return npos;
+	const std::uint64_t h = hash(id);
+	const std::size_t b = bucket_of(h);
+	const std::size_t capacity = static_cast<std::size_t>(offsets_view[b + 1] - offsets_view[b]);
+	if (capacity == 0)
+		return npos;
+	const internal_id_t* region = table_view + offsets_view[b];
+	for (std::size_t slot = static_cast<std::size_t>(h) & (capacity - 1);; slot = (slot + 1) & (capacity - 1)) {
+		const internal_id_t entry = region[slot];
+		if (entry == 0)
+			return npos;
+		if (ids_view[entry - 1] == id)
+			return static_cast<internal_id_t>(entry - 1);
+	}
+}
+
+VERTEX_DICTIONARY_TEMPLATE
+void VERTEX_DICTIONARY::translate(const external_id_t* input, std::size_t n, internal_id_t* out, std::size_t num_threads) const
+{
+	parallel_for(resolve_threads(num_threads), n, [&](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i)
+			out[i] = find(input[i]);
+	});
+}
+
+VERTEX_DICTIONARY_TEMPLATE
+template <typename InEdgeTy, typename OutEdgeTy>
+void VERTEX_DICTIONARY::translate_edges(const InEdgeTy* in, std::size_t n, OutEdgeTy* out, std::size_t num_threads) const
+{
+	using out_vertex_id_t = decltype(out->src);
+	parallel_for(resolve_threads(num_threads), n, [&](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			out[i].src = static_cast<out_vertex_id_t>(find(static_cast<external_id_t>(in[i].src)));
+			out[i].dst = static_cast<out_vertex_id_t>(find(static_cast<external_id_t>(in[i].dst)));
+			_vertex_dictionary::payload_copy<InEdgeTy, OutEdgeTy>::copy(in[i], out[i]);
+		}
+	});
+}
+
+VERTEX_DICTIONARY_TEMPLATE
+bool VERTEX_DICTIONARY::write(const char* filepath) const
+{
+	std::ofstream ofs{ filepath, std::ios::out | std::ios::binary | std::ios::trunc };
+	if (!ofs.is_open())
+		return false;
+	vertex_dictionary_header header;
+	memset(&header, 0, sizeof(vertex_dictionary_header));
+	header.magic = vertex_dictionary_header::Magic;
+	header.external_id_size = sizeof(external_id_t);
+	header.internal_id_size = sizeof(internal_id_t);
+	header.num_vertices = static_cast<std::uint64_t>(num_vertices);
+	header.num_buckets = static_cast<std::uint64_t>(num_buckets);
+	header.table_size = (num_buckets > 0) ? offsets_view[num_buckets] : 0;
+	ofs.write(reinterpret_cast<const char*>(&header), sizeof(vertex_dictionary_header));
+	if (num_vertices > 0) {
+		ofs.write(reinterpret_cast<const char*>(ids_view), static_cast<std::streamsize>(sizeof(external_id_t) * num_vertices));
+		ofs.write(reinterpret_cast<const char*>(offsets_view), static_cast<std::streamsize>(sizeof(std::uint64_t) * (num_buckets + 1)));
+		ofs.write(reinterpret_cast<const char*>(table_view), static_cast<std::streamsize>(sizeof(internal_id_t) * header.table_size));
+	}
+	ofs.flush();
+	return ofs.good();
+}
+
+VERTEX_DICTIONARY_TEMPLATE
+bool VERTEX_DICTIONARY::open(const char* filepath)
+{
+	clear();
+	if (!file.open(filepath) || file.size() < sizeof(vertex_dictionary_header))
+		return false;
+	vertex_dictionary_header header;
+	memcpy(&header, file.data(), sizeof(vertex_dictionary_header));
+	const std::size_t ids_size = sizeof(external_id_t) * static_cast<std::size_t>(header.num_vertices);
+	const std::size_t offsets_size = (header.num_vertices > 0) ? sizeof(std::uint64_t) * static_cast<std::size_t>(header.num_buckets + 1) : 0;
+	const std::size_t table_size = sizeof(internal_id_t) * static_cast<std::size_t>(header.table_size);
+	if (header.magic != vertex_dictionary_header::Magic || header.external_id_size != sizeof(external_id_t) || header.internal_id_size != sizeof(internal_id_t)
+		|| file.size() < sizeof(vertex_dictionary_header) + ids_size + offsets_size + table_size) {
+		file.close();
+		return false;
+	}
+	const std::uint8_t* data = file.data() + sizeof(vertex_dictionary_header);
+	ids_view = reinterpret_cast<const external_id_t*>(data);
+	offsets_view = reinterpret_cast<const std::uint64_t*>(data + ids_size);
+	table_view = reinterpret_cast<const internal_id_t*>(data + ids_size + offsets_size);
+	num_vertices = static_cast<std::size_t>(header.num_vertices);
+	num_buckets = static_cast<std::size_t>(header.num_buckets);
+	return true;
+}
+
+#undef VERTEX_DICTIONARY
+#undef VERTEX_DICTIONARY_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_VERTEX_DICTIONARY_H_
@@ -0,0 +1,220 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		vertex_index.h
+*	@brief		Dense vertex_id -> (page_id, slot_offset, is_lp) index file
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_VERTEX_INDEX_H_
+#define _GSTREAM_DATATYPE_VERTEX_INDEX_H_
+
+#include <gstream/io/mapped_file.h>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** Vertex index
+** One fixed-size entry per vertex of [first_vid, first_vid + n):
+**     entry = { page_id, slot_offset, flags }
+** page_id is the head page for a vertex stored in large pages
+** (flags & LP), so a lookup is a single array access instead of a
+** scan (vid_to_pid) or a binary search of the RID table.
+**
+** File layout (little endian, packed)
+**     header { magic "PGDBVIDX", page_id_size, slot_offset_size,
+**              first_vid, num_vertices }
+**     entry[num_vertices]
+** open() maps the file read-only, so that a query service pays no
+** load time and shares the page cache with other processes.
+**
+** The index is built from a RID table (build()) or recorded by
+** pagedb_generator while it places the vertices
+** (enable_vertex_index()).
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+namespace vertex_index_flag {
+constexpr std::uint8_t LP = 0x01; // the vertex is stored in a large-page chain starting at page_id
+} // !namespace vertex_index_flag
+
+#pragma pack(push, 1)
+template <typename PageIdTy, typename SlotOffsetTy>
+struct vertex_index_entry {
+	PageIdTy     page_id;
+	SlotOffsetTy slot_offset;
+	std::uint8_t flags;
+	inline bool is_lp() const
+	{
+		return 0 != (flags & vertex_index_flag::LP);
+	}
+};
+
+struct vertex_index_header {
+	static constexpr std::uint64_t Magic = 0x5844495642444750ull; // "PGDBVIDX"
+	std::uint64_t magic;
+	std::uint32_t page_id_size;
+	std::uint32_t slot_offset_size;
+	std::uint64_t first_vid;
+	std::uint64_t num_vertices;
+};
+#pragma pack(pop)
+
+template <typename VertexIdTy, typename PageIdTy, typename SlotOffsetTy>
+class vertex_index {
+public:
+	using vertex_id_t = VertexIdTy;
+	using page_id_t = PageIdTy;
+	using slot_offset_t = SlotOffsetTy;
+	using entry_t = vertex_index_entry<page_id_t, slot_offset_t>;
+
+	vertex_index() = default;
+	vertex_index(const vertex_index&) = delete;
+	vertex_index& operator=(const vertex_index&) = delete;
+
+	/// Build: from a RID table; num_vertices: the number of vertex ids from rid_table[0].start_vid
+	template <typename RIDTableTy>
+	void build(const RIDTableTy& rid_table, std::size_t num_vertices);
+	/// Append: the location of the next vertex (vertex ids are consecutive from the first appended one)
+	void append(vertex_id_t vid, page_id_t page_id, slot_offset_t slot_offset, bool is_lp);
+	void clear();
+
+	bool write(const char* filepath) const;
+	/// Open: map an index file written by write(); the in-memory entries are released
+	bool open(const char* filepath);
+
+	inline bool contains(vertex_id_t vid) const
+	{
+		return vid >= first_vid && static_cast<std::size_t>(vid - first_vid) < num_entries;
+	}
+	/// Lookup: O(1); precondition: contains(vid)
+	inline const entry_t& operator[](vertex_id_t vid) const
+	{
+		return table[static_cast<std::size_t>(vid - first_vid)];
+	}
+	inline std::size_t size() const
+	{
+		return num_entries;
+	}
+	inline vertex_id_t first_vertex_id() const
+	{
+		return first_vid;
+	}
+
+protected:
+	inline void sync_view()
+	{
+		table = entries.data();
+		num_entries = entries.size();
+	}
+
+	std::vector<entry_t> entries; // in-memory index (build/append)
+	mapped_file          file;    // mapped index (open)
+	const entry_t*       table{ nullptr };
+	std::size_t          num_entries{ 0 };
+	vertex_id_t          first_vid{ 0 };
+};
+
+#define VERTEX_INDEX_TEMPLATE template <typename VertexIdTy, typename PageIdTy, typename SlotOffsetTy>
+#define VERTEX_INDEX vertex_index<VertexIdTy, PageIdTy, SlotOffsetTy>
+
+VERTEX_INDEX_TEMPLATE
+template <typename RIDTableTy>
+void VERTEX_INDEX::build(const RIDTableTy& rid_table, std::size_t num_vertices)
+{
+	clear();
+	if (rid_table.size() == 0)
+		return;
+	first_vid = static_cast<vertex_id_t>(rid_table[0].start_vid);
+	entries.resize(num_vertices);
+	const std::size_t num_pages = rid_table.size();
+	for (std::size_t pid = 0; pid < num_pages; ++pid) {
+		const std::size_t start = static_cast<std::size_t>(rid_table[pid].start_vid - first_vid);
+		if (rid_table[pid].auxiliary != 0) {
+			// Large page: the head holds the vertex, extended pages repeat its start_vid
+			if ((pid == 0 || rid_table[pid - 1].start_vid != rid_table[pid].start_vid) && start < num_vertices)
+				entries[start] = entry_t{ static_cast<page_id_t>(pid), 0, vertex_index_flag::LP };
+			continue;
+		}
+		const std::size_t end = (pid + 1 < num_pages) ? static_cast<std::size_t>(rid_table[pid + 1].start_vid - first_vid) : num_vertices;
+		for (std::size_t v = start; v < end && v < num_vertices; ++v)
+			entries[v] = entry_t{ static_cast<page_id_t>(pid), static_cast<slot_offset_t>(v - start), 0 };
+	}
+	sync_view();
+}
+
+VERTEX_INDEX_TEMPLATE
+void VERTEX_INDEX::append(vertex_id_t vid, page_id_t page_id, slot_offset_t slot_offset, bool is_lp)
+{
+	if (entries.empty())
+		first_vid = vid;
+	entries.push_back(entry_t{ page_id, slot_offset, static_cast<std::uint8_t>(is_lp ? vertex_index_flag::LP : 0) });
+	sync_view();
+}
+
+VERTEX_INDEX_TEMPLATE
+void VERTEX_INDEX::clear()
+{
+	file.close();
+	entries.clear();
+	table = nullptr;
+	num_entries = 0;
+	first_vid = 0;
+}
+
+VERTEX_INDEX_TEMPLATE
+bool VERTEX_INDEX::write(const char* filepath) const
+{
+	std::ofstream ofs{ filepath, std::ios::out | std::ios::binary | std::ios::trunc };
+	if (!ofs.is_open())
+		return false;
+	vertex_index_header header;
+	memset(&header, 0, sizeof(vertex_index_header));
+	header.magic = vertex_index_header::Magic;
+	header.page_id_size = sizeof(page_id_t);
+	header.slot_offset_size = sizeof(slot_offset_t);
+	header.first_vid = static_cast<std::uint64_t>(first_vid);
+	header.num_vertices = static_cast<std::uint64_t>(num_entries);
+	ofs.write(reinterpret_cast<const char*>(&header), sizeof(vertex_index_header));
+	if (num_entries > 0)
+		ofs.write(reinterpret_cast<const char*>(table), static_cast<std::streamsize>(sizeof(entry_t) * num_entries));
+	ofs.flush();
+	return ofs.good();
+}
+
+VERTEX_INDEX_TEMPLATE
+bool VERTEX_INDEX::open(const char* filepath)
+{
+	clear();
+	if (!file.open(filepath) || file.size() < sizeof(vertex_index_header))
+		return false;
+	vertex_index_header header;
+	memcpy(&header, file.data(), sizeof(vertex_index_header));
+	// The entries must fill the rest of the file exactly; num_vertices is compared by division so that it cannot overflow
+	const std::size_t entry_bytes = file.size() - sizeof(vertex_index_header);
+	const std::uint64_t max_vid = static_cast<std::uint64_t>(std::numeric_limits<vertex_id_t>::max());
+	if (header.magic != vertex_index_header::Magic || header.page_id_size != sizeof(page_id_t) || header.slot_offset_size != sizeof(slot_offset_t)
+		|| 0 != entry_bytes % sizeof(entry_t) || header.num_vertices != static_cast<std::uint64_t>(entry_bytes / sizeof(entry_t))
+		|| header.first_vid > max_vid || (header.num_vertices > 0 && header.num_vertices - 1 > max_vid - header.first_vid)) {
+		file.close();
+		return false;
+	}
+	table = reinterpret_cast<const entry_t*>(file.data() + sizeof(vertex_index_header));
+	num_entries = static_cast<std::size_t>(header.num_vertices);
+	first_vid = static_cast<vertex_id_t>(header.first_vid);
+	return true;
+}
+
+#undef VERTEX_INDEX
+#undef VERTEX_INDEX_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_VERTEX_INDEX_H_
@@ -0,0 +1,229 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/datatype
+*	@file		vertex_reorder.h
+*	@brief		Locality-improving vertex relabeling before page packing
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_DATATYPE_VERTEX_REORDER_H_
+#define _GSTREAM_DATATYPE_VERTEX_REORDER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** Vertex reordering
+** rid_table_generator packs vertices in ID order, so the page
+** locality of a PageDB is decided by the input vertex IDs.
+** A reordering stage relabels the vertex IDs of an edge set before
+** the generation, so that neighbours mostly land in the same or
+** nearby pages.
+**
+**   auto perm = gstream::make_vertex_permutation(edges, n, gstream::reorder_method_t::rcm);
+**   gstream::relabel_edges(edges, n, perm);       // sorted by new src
+**   gstream::write_permutation(perm, ofs);        // new -> original
+**   ... rid_table_generator / pagedb_generator with the relabeled edges
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+enum class reorder_method_t {
+	identity,
+	degree_sort, // descending degree (hubs first)
+	bfs,         // breadth-first order from the highest-degree vertex of each component
+	rcm,         // reverse Cuthill-McKee
+};
+
+template <typename VertexIdTy>
+struct vertex_permutation {
+	using vertex_id_t = VertexIdTy;
+	std::vector<vertex_id_t> new_id;      // indexed by original vertex id
+	std::vector<vertex_id_t> original_id; // indexed by new vertex id
+	inline std::size_t size() const
+	{
+		return original_id.size();
+	}
+};
+
+namespace _vertex_reorder {
+
+// Undirected adjacency in CSR form
+template <typename EdgeTy>
+void build_undirected_csr(const EdgeTy* edges, std::size_t num_edges, std::size_t num_vertices, std::vector<std::size_t>& offsets, std::vector<std::size_t>& neighbors)
+{
+	offsets.assign(num_vertices + 1, 0);
+	for (std::size_t i = 0; i < num_edges; ++i) {
+		++offsets[static_cast<std::size_t>(edges[i].src) + 1];
+		++offsets[static_cast<std::size_t>(edges[i].dst) + 1];
+	}
+	for (std::size_t v = 0; v < num_vertices; ++v)
+		offsets[v + 1] += offsets[v];
+	neighbors.resize(offsets[num_vertices]);
+	std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+	for (std::size_t i = 0; i < num_edges; ++i) {
+		neighbors[cursor[static_cast<std::size_t>(edges[i].src)]++] = static_cast<std::size_t>(edges[i].dst);
+		neighbors[cursor[static_cast<std::size_t>(edges[i].dst)]++] = static_cast<std::size_t>(edges[i].src);
+	}
+}
+
+// Cuthill-McKee style traversal: each component starts at its minimum (or maximum) degree vertex,
+// neighbours are visited in ascending degree
+inline void traverse(const std::vector<std::size_t>& offsets, const std::vector<std::size_t>& neighbors, std::vector<std::size_t>& order, bool minimum_degree_root)
+{
+	const std::size_t num_vertices = offsets.size() - 1;
+	auto degree = [&](std::size_t v) { return offsets[v + 1] - offsets[v]; };
+	// Root candidates sorted by degree; ties by id
+	std::vector<std::size_t> roots(num_vertices);
+	for (std::size_t v = 0; v < num_vertices; ++v)
+		roots[v] = v;
+	std::stable_sort(roots.begin(), roots.end(), [&](std::size_t lhs, std::size_t rhs) {
+		return minimum_degree_root ? (degree(lhs) < degree(rhs)) : (degree(lhs) > degree(rhs));
+	});
+
+	std::vector<bool> visited(num_vertices, false);
+	std::vector<std::size_t> level;
+	order.clear();
+	order.reserve(num_vertices);
+	for (std::size_t root : roots) {
+		if (visited[root])
+			continue;
+		visited[root] = true;
+		std::size_t head = order.size();
+		order.push_back(root);
+		while (head < order.size()) {
+			std::size_t v = order[head++];
+			level.clear();
+			for (std::size_t i = offsets[v]; i < offsets[v + 1]; ++i) {
+				std::size_t u = neighbors[i];
+				if (!visited[u]) {
+					visited[u] = true;
+					level.push_back(u);
+				}
+			}
+			std::stable_sort(level.begin(), level.end(), [&](std::size_t lhs, std::size_t rhs) { return degree(lhs) < degree(rhs); });
+			order.insert(order.end(), level.begin(), level.end());
+		}
+	}
+}
+
+} // !namespace _vertex_reorder
+
+/// Make a permutation of [0, num_vertices); num_vertices = 0: max vertex id in the edge set + 1
+template <typename EdgeTy>
+vertex_permutation<typename EdgeTy::vertex_id_t> make_vertex_permutation(const EdgeTy* edges, std::size_t num_edges, reorder_method_t method, std::size_t num_vertices = 0)
+{
+	using vertex_id_t = typename EdgeTy::vertex_id_t;
+	for (std::size_t i = 0; i < num_edges; ++i) {
+		std::size_t max_id = static_cast<std::size_t>(std::max(edges[i].src, edges[i].dst));
+		if (max_id >= num_vertices)
+			num_vertices = max_id + 1;
+	}
+
+	std::vector<std::size_t> order;
+	if (method == reorder_method_t::identity) {
+		order.resize(num_vertices);
+		for (std::size_t v = 0; v < num_vertices; ++v)
+			order[v] = v;
+	}
+	else {
+		std::vector<std::size_t> offsets, neighbors;
+		_vertex_reorder::build_undirected_csr(edges, num_edges, num_vertices, offsets, neighbors);
+		if (method == reorder_method_t::degree_sort) {
+			order.resize(num_vertices);
+			for (std::size_t v = 0; v < num_vertices; ++v)
+				order[v] = v;
+			std::stable_sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+				return (offsets[lhs + 1] - offsets[lhs]) > (offsets[rhs + 1] - offsets[rhs]);
+			});
+		}
+		else {
+			_vertex_reorder::traverse(offsets, neighbors, order, method == reorder_method_t::rcm);
+			if (method == reorder_method_t::rcm)
+				std::reverse(order.begin(), order.end());
+		}
+	}
+
+	vertex_permutation<vertex_id_t> perm;
+	perm.original_id.resize(num_vertices);
+	perm.new_id.resize(num_vertices);
+	for (std::size_t new_id = 0; new_id < num_vertices; ++new_id) {
+		perm.original_id[new_id] = static_cast<vertex_id_t>(order[new_id]);
+		perm.new_id[order[new_id]] = static_cast<vertex_id_t>(new_id);
+	}
+	return perm;
+}
+
+/// Relabel an edge set in place and sort it by the new source id (the input order of the generators)
+template <typename EdgeTy>
+void relabel_edges(EdgeTy* edges, std::size_t num_edges, const vertex_permutation<typename EdgeTy::vertex_id_t>& perm)
+{
+	for (std::size_t i = 0; i < num_edges; ++i) {
+		edges[i].src = perm.new_id[static_cast<std::size_t>(edges[i].src)];
+		edges[i].dst = perm.new_id[static_cast<std::size_t>(edges[i].dst)];
+	}
+	std::stable_sort(edges, edges + num_edges, [](const EdgeTy& lhs, const EdgeTy& rhs) {
+		return (lhs.src < rhs.src) || ((lhs.src == rhs.src) && (lhs.dst < rhs.dst));
+	});
+}
+
+/// Relabel a vertex set in place and sort it by the new vertex id
+template <typename VertexTy>
+void relabel_vertices(VertexTy* vertices, std::size_t num_vertices, const vertex_permutation<typename VertexTy::vertex_id_t>& perm)
+{
+	for (std::size_t i = 0; i < num_vertices; ++i)
+		vertices[i].vertex_id = perm.new_id[static_cast<std::size_t>(vertices[i].vertex_id)];
+	std::stable_sort(vertices, vertices + num_vertices, [](const VertexTy& lhs, const VertexTy& rhs) { return lhs.vertex_id < rhs.vertex_id; });
+}
+
+/// Permutation file: original vertex ids ordered by the new vertex id
+template <typename VertexIdTy>
+void write_permutation(const vertex_permutation<VertexIdTy>& perm, std::ostream& os)
+{
+	os.write(reinterpret_cast<const char*>(perm.original_id.data()), static_cast<std::streamsize>(sizeof(VertexIdTy) * perm.original_id.size()));
+}
+
+// False if the file cannot be read, its length is not a whole number of ids, or the ids are not a permutation of [0, n)
+template <typename VertexIdTy>
+bool read_permutation(vertex_permutation<VertexIdTy>& perm, const char* filepath)
+{
+	perm.original_id.clear();
+	perm.new_id.clear();
+	std::ifstream ifs{ filepath, std::ios::in | std::ios::binary };
+	if (!ifs.is_open())
+		return false;
+	ifs.seekg(0, std::ios::end);
+	const std::streamoff length = ifs.tellg();
+	if (length < 0 || 0 != static_cast<std::size_t>(length) % sizeof(VertexIdTy))
+		return false;
+	const std::size_t num_vertices = static_cast<std::size_t>(length) / sizeof(VertexIdTy);
+	ifs.seekg(0, std::ios::beg);
+	std::vector<VertexIdTy> original_id(num_vertices);
+	ifs.read(reinterpret_cast<char*>(original_id.data()), static_cast<std::streamsize>(sizeof(VertexIdTy) * num_vertices));
+	if (static_cast<std::size_t>(ifs.gcount()) != sizeof(VertexIdTy) * num_vertices)
+		return false;
+
+	// Every original id in [0, n) exactly once
+	std::vector<VertexIdTy> new_id(num_vertices);
+	std::vector<bool> seen(num_vertices, false);
+	for (std::size_t id = 0; id < num_vertices; ++id) {
+		const std::size_t vid = static_cast<std::size_t>(original_id[id]);
+		if (vid >= num_vertices || seen[vid])
+			return false;
+		seen[vid] = true;
+		new_id[vid] = static_cast<VertexIdTy>(id);
+	}
+	perm.original_id.swap(original_id);
+	perm.new_id.swap(new_id);
+	return true;
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_DATATYPE_VERTEX_REORDER_H_
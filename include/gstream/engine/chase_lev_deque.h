@@ -0,0 +1,179 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/engine
+*	@file		chase_lev_deque.h
+*	@brief		Lock-free work-stealing deque (Chase-Lev)
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_ENGINE_CHASE_LEV_DEQUE_H_
+#define _GSTREAM_ENGINE_CHASE_LEV_DEQUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** chase_lev_deque
+** "Dynamic Circular Work-Stealing Deque" (Chase and Lev, SPAA'05)
+** with the C11 memory orderings of Le et al. (PPoPP'13).
+** - The owner thread calls push() and pop() on the bottom end.
+** - Any other thread calls steal() on the top end.
+** Elements are integral values (e.g. task indices) so that every
+** slot can be an std::atomic. Grown buffers are retired, not freed,
+** until the deque is destroyed, because a thief may still read them.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+template <typename ValueTy>
+class chase_lev_deque {
+	static_assert(std::is_integral<ValueTy>::value, "chase_lev_deque holds integral values (e.g. task indices)");
+public:
+	using value_t = ValueTy;
+
+	enum class steal_result_t {
+		success,
+		empty,
+		abort, // lost a race; the deque may not be empty
+	};
+
+	explicit chase_lev_deque(std::size_t initial_capacity = 64);
+	chase_lev_deque(const chase_lev_deque&) = delete;
+	chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+
+	// Owner only
+	void push(value_t value);
+	bool pop(value_t& out);
+	// Any thread
+	steal_result_t steal(value_t& out);
+
+	inline std::size_t size_hint() const
+	{
+		std::int64_t b = bottom.load(std::memory_order_relaxed);
+		std::int64_t t = top.load(std::memory_order_relaxed);
+		return (b > t) ? static_cast<std::size_t>(b - t) : 0;
+	}
+
+protected:
+	struct ring_buffer {
+		explicit ring_buffer(std::size_t capacity_) :
+			capacity{ capacity_ },
+			mask{ capacity_ - 1 },
+			slots{ new std::atomic<value_t>[capacity_] }
+		{
+		}
+		inline value_t get(std::int64_t index) const
+		{
+			return slots[static_cast<std::size_t>(index) & mask].load(std::memory_order_relaxed);
+		}
+		inline void put(std::int64_t index, value_t value)
+		{
+			slots[static_cast<std::size_t>(index) & mask].store(value, std::memory_order_relaxed);
+		}
+		std::size_t capacity; // power of two
+		std::size_t mask;
+		std::unique_ptr<std::atomic<value_t>[]> slots;
+	};
+
+	ring_buffer* grow(ring_buffer* old_buffer, std::int64_t b, std::int64_t t);
+
+	// top (thieves) and bottom (owner) on separate cache lines; padding instead of alignas(64),
+	// which operator new does not honour before C++17
+	std::atomic<std::int64_t> top;
+	char pad0[64 - sizeof(std::atomic<std::int64_t>)];
+	std::atomic<std::int64_t> bottom;
+	char pad1[64 - sizeof(std::atomic<std::int64_t>)];
+	std::atomic<ring_buffer*> buffer;
+	std::vector<std::unique_ptr<ring_buffer>> buffers; // current and retired buffers (owner only)
+};
+
+#define CHASE_LEV_DEQUE_TEMPLATE template <typename ValueTy>
+#define CHASE_LEV_DEQUE chase_lev_deque<ValueTy>
+
+CHASE_LEV_DEQUE_TEMPLATE
+CHASE_LEV_DEQUE::chase_lev_deque(std::size_t initial_capacity) :
+	top{ 0 },
+	bottom{ 0 }
+{
+	std::size_t capacity = 2;
+	while (capacity < initial_capacity)
+		capacity <<= 1;
+	buffers.emplace_back(new ring_buffer{ capacity });
+	buffer.store(buffers.back().get(), std::memory_order_relaxed);
+}
+
+CHASE_LEV_DEQUE_TEMPLATE
+typename CHASE_LEV_DEQUE::ring_buffer* CHASE_LEV_DEQUE::grow(ring_buffer* old_buffer, std::int64_t b, std::int64_t t)
+{
+	buffers.emplace_back(new ring_buffer{ old_buffer->capacity << 1 });
+	ring_buffer* new_buffer = buffers.back().get();
+	for (std::int64_t i = t; i < b; ++i)
+		new_buffer->put(i, old_buffer->get(i));
+	return new_buffer;
+}
+
+CHASE_LEV_DEQUE_TEMPLATE
+void CHASE_LEV_DEQUE::push(value_t value)
+{
+	std::int64_t b = bottom.load(std::memory_order_relaxed);
+	std::int64_t t = top.load(std::memory_order_acquire);
+	ring_buffer* a = buffer.load(std::memory_order_relaxed);
+	if (b - t > static_cast<std::int64_t>(a->capacity) - 1) {
+		a = grow(a, b, t);
+		buffer.store(a, std::memory_order_release);
+	}
+	a->put(b, value);
+	std::atomic_thread_fence(std::memory_order_release);
+	bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+CHASE_LEV_DEQUE_TEMPLATE
+bool CHASE_LEV_DEQUE::pop(value_t& out)
+{
+	std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+	ring_buffer* a = buffer.load(std::memory_order_relaxed);
+	bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t t = top.load(std::memory_order_relaxed);
+	if (t > b) {
+		// Empty
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return false;
+	}
+	out = a->get(b);
+	if (t == b) {
+		// The last element: race against thieves
+		bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return won;
+	}
+	return true;
+}
+
+CHASE_LEV_DEQUE_TEMPLATE
+typename CHASE_LEV_DEQUE::steal_result_t CHASE_LEV_DEQUE::steal(value_t& out)
+{
+	std::int64_t t = top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t b = bottom.load(std::memory_order_acquire);
+	if (t >= b)
+		return steal_result_t::empty;
+	ring_buffer* a = buffer.load(std::memory_order_acquire);
+	out = a->get(t);
+	if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		return steal_result_t::abort;
+	return steal_result_t::success;
+}
+
+#undef CHASE_LEV_DEQUE
+#undef CHASE_LEV_DEQUE_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_ENGINE_CHASE_LEV_DEQUE_H_
@@ -0,0 +1,317 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/engine
+*	@file		frontier.h
+*	@brief		Page frontier: sparse (page, slot) queues and dense per-page bitmaps
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_ENGINE_FRONTIER_H_
+#define _GSTREAM_ENGINE_FRONTIER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#if _WIN32 || _WIN64
+#include <intrin.h>
+#endif
+
+/* ---------------------------------------------------------------
+**
+** page_frontier
+** The set of active vertices of a traversal, addressed by
+** (page_id, slot_offset) like adj_list_element.
+** - dense:  one bit-block per page (64-bit words, a page never shares
+**           a word with another page) plus a per-page summary flag,
+**           so that inactive pages are skipped without being read
+** - sparse: per-thread queues of (page, slot) entries
+** The bitmap is always maintained (it also deduplicates activations);
+** the queues are kept while the frontier is sparse. Once the number
+** of active vertices exceeds dense_threshold * number of vertices the
+** frontier switches to dense and the queues are dropped. clear()
+** resets only the touched words while sparse.
+** The extended pages of a large page share the block of the head.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+inline std::size_t count_trailing_zeros(std::uint64_t word)
+{
+#if _WIN32 || _WIN64
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return static_cast<std::size_t>(index);
+#else
+	return static_cast<std::size_t>(__builtin_ctzll(word));
+#endif
+}
+
+enum class frontier_mode_t {
+	sparse,
+	dense,
+};
+
+template <typename PageIdTy = std::uint32_t, typename SlotOffsetTy = std::uint32_t>
+class page_frontier {
+public:
+	using page_id_t = PageIdTy;
+	using slot_offset_t = SlotOffsetTy;
+	using word_t = std::uint64_t;
+	static constexpr std::size_t BitsPerWord = 64;
+
+	struct entry {
+		page_id_t     page_id;
+		slot_offset_t slot_offset;
+	};
+
+	/// num_vertices: the number of vertex ids covered by the RID table, starting at rid_table[0].start_vid
+	template <typename RIDTableTy>
+	page_frontier(const RIDTableTy& rid_table, std::size_t num_vertices, std::size_t num_threads = 1, double dense_threshold_ = 0.05);
+	page_frontier(const page_frontier&) = delete;
+	page_frontier& operator=(const page_frontier&) = delete;
+
+	/// Activate: thread-safe; returns true if the vertex was not active yet
+	bool activate(page_id_t page_id, slot_offset_t slot_offset, std::size_t thread_id = 0);
+
+	inline bool is_active(page_id_t page_id, slot_offset_t slot_offset) const
+	{
+		const std::size_t bit = bit_index(page_id, slot_offset);
+		return 0 != (words[bit / BitsPerWord].load(std::memory_order_relaxed) & (word_t{ 1 } << (bit % BitsPerWord)));
+	}
+	/// Is any slot of this page active (extended pages report their head)
+	inline bool is_page_active(page_id_t page_id) const
+	{
+		return 0 != summary[block_page[page_id]].load(std::memory_order_relaxed);
+	}
+
+	inline frontier_mode_t mode() const
+	{
+		return dense.load(std::memory_order_relaxed) ? frontier_mode_t::dense : frontier_mode_t::sparse;
+	}
+	inline std::size_t size() const
+	{
+		return num_active.load(std::memory_order_relaxed);
+	}
+	inline bool empty() const
+	{
+		return size() == 0;
+	}
+	inline std::size_t number_of_pages() const
+	{
+		return block_page.size();
+	}
+
+	/// Clear: not thread-safe with concurrent activations
+	void clear();
+
+	/// For each active vertex: fn(page_id, slot_offset), in page order when dense
+	template <typename FnTy>
+	void for_each(FnTy fn) const;
+	/// For each active vertex of the pages [first_page, last_page) (dense scan; e.g. a scheduler task)
+	template <typename FnTy>
+	void for_each_in_pages(std::size_t first_page, std::size_t last_page, FnTy fn) const;
+	/// For each page with at least one active slot: fn(page_id); extended pages are not reported
+	template <typename FnTy>
+	void for_each_active_page(FnTy fn) const;
+
+	/// Sparse entries sorted by (page, slot); built from the bitmap when dense
+	std::vector<entry> to_sparse() const;
+
+	void swap(page_frontier& other);
+
+protected:
+	inline std::size_t bit_index(page_id_t page_id, slot_offset_t slot_offset) const
+	{
+		return word_base[page_id] * BitsPerWord + static_cast<std::size_t>(slot_offset);
+	}
+
+	std::vector<std::size_t> word_base;  // first word of the block of each page
+	std::vector<std::size_t> num_slots;  // slots of each page (0 for extended pages)
+	std::vector<std::size_t> block_page; // page owning the block (the head for extended pages)
+	std::size_t num_vertices;
+	std::size_t num_words;
+	std::unique_ptr<std::atomic<word_t>[]>  words;
+	std::unique_ptr<std::atomic<uint8_t>[]> summary;
+	std::vector<std::vector<entry>> queues; // per thread
+	std::atomic<std::size_t> num_active;
+	std::atomic<bool>        dense;
+	double                   dense_threshold;
+};
+
+#define PAGE_FRONTIER_TEMPLATE template <typename PageIdTy, typename SlotOffsetTy>
+#define PAGE_FRONTIER page_frontier<PageIdTy, SlotOffsetTy>
+
+PAGE_FRONTIER_TEMPLATE
+template <typename RIDTableTy>
+PAGE_FRONTIER::page_frontier(const RIDTableTy& rid_table, std::size_t num_vertices_, std::size_t num_threads, double dense_threshold_) :
+	num_vertices{ num_vertices_ },
+	num_words{ 0 },
+	queues(std::max<std::size_t>(1, num_threads)),
+	num_active{ 0 },
+	dense{ false },
+	dense_threshold{ dense_threshold_ }
+{
+	const std::size_t num_pages = rid_table.size();
+	const std::size_t first_vid = (num_pages > 0) ? static_cast<std::size_t>(rid_table[0].start_vid) : 0;
+	word_base.resize(num_pages);
+	num_slots.resize(num_pages);
+	block_page.resize(num_pages);
+	for (std::size_t pid = 0; pid < num_pages; ++pid) {
+		if (pid > 0 && rid_table[pid].start_vid == rid_table[pid - 1].start_vid) {
+			word_base[pid] = word_base[pid - 1];
+			num_slots[pid] = 0;
+			block_page[pid] = block_page[pid - 1];
+			continue;
+		}
+		std::size_t end = num_vertices;
+		for (std::size_t next = pid + 1; next < num_pages; ++next) {
+			if (rid_table[next].start_vid != rid_table[pid].start_vid) {
+				end = static_cast<std::size_t>(rid_table[next].start_vid) - first_vid;
+				break;
+			}
+		}
+		const std::size_t start = static_cast<std::size_t>(rid_table[pid].start_vid) - first_vid;
+		word_base[pid] = num_words;
+		num_slots[pid] = (end > start) ? (end - start) : 0;
+		block_page[pid] = pid;
+		num_words += (num_slots[pid] + BitsPerWord - 1) / BitsPerWord;
+	}
+	words.reset(new std::atomic<word_t>[(num_words > 0) ? num_words : 1]);
+	for (std::size_t i = 0; i < num_words; ++i)
+		words[i].store(0, std::memory_order_relaxed);
+	summary.reset(new std::atomic<uint8_t>[(num_pages > 0) ? num_pages : 1]);
+	for (std::size_t i = 0; i < num_pages; ++i)
+		summary[i].store(0, std::memory_order_relaxed);
+}
+
+PAGE_FRONTIER_TEMPLATE
+bool PAGE_FRONTIER::activate(page_id_t page_id, slot_offset_t slot_offset, std::size_t thread_id)
+{
+	const std::size_t bit = bit_index(page_id, slot_offset);
+	const word_t mask = word_t{ 1 } << (bit % BitsPerWord);
+	if (words[bit / BitsPerWord].fetch_or(mask, std::memory_order_acq_rel) & mask)
+		return false; // already active
+
+	const std::size_t owner = block_page[page_id];
+	if (0 == summary[owner].load(std::memory_order_relaxed))
+		summary[owner].store(1, std::memory_order_relaxed);
+
+	const std::size_t count = num_active.fetch_add(1, std::memory_order_relaxed) + 1;
+	if (!dense.load(std::memory_order_relaxed)) {
+		if (static_cast<double>(count) > dense_threshold * static_cast<double>(num_vertices))
+			dense.store(true, std::memory_order_relaxed); // queues are stale from now on
+		else
+			queues[thread_id].push_back(entry{ static_cast<page_id_t>(owner), slot_offset });
+	}
+	return true;
+}
+
+PAGE_FRONTIER_TEMPLATE
+void PAGE_FRONTIER::clear()
+{
+	if (dense.load(std::memory_order_relaxed)) {
+		for (std::size_t i = 0; i < num_words; ++i)
+			words[i].store(0, std::memory_order_relaxed);
+		for (std::size_t i = 0; i < block_page.size(); ++i)
+			summary[i].store(0, std::memory_order_relaxed);
+	}
+	else {
+		for (auto& queue : queues) {
+			for (const entry& e : queue) {
+				words[bit_index(e.page_id, e.slot_offset) / BitsPerWord].store(0, std::memory_order_relaxed);
+				summary[e.page_id].store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+	for (auto& queue : queues)
+		queue.clear();
+	num_active.store(0, std::memory_order_relaxed);
+	dense.store(false, std::memory_order_relaxed);
+}
+
+PAGE_FRONTIER_TEMPLATE
+template <typename FnTy>
+void PAGE_FRONTIER::for_each_in_pages(std::size_t first_page, std::size_t last_page, FnTy fn) const
+{
+	for (std::size_t pid = first_page; pid < last_page; ++pid) {
+		if (0 == num_slots[pid] || 0 == summary[pid].load(std::memory_order_relaxed))
+			continue;
+		const std::size_t num_page_words = (num_slots[pid] + BitsPerWord - 1) / BitsPerWord;
+		for (std::size_t w = 0; w < num_page_words; ++w) {
+			word_t word = words[word_base[pid] + w].load(std::memory_order_relaxed);
+			while (word) {
+				const std::size_t bit = count_trailing_zeros(word);
+				word &= word - 1;
+				fn(static_cast<page_id_t>(pid), static_cast<slot_offset_t>(w * BitsPerWord + bit));
+			}
+		}
+	}
+}
+
+PAGE_FRONTIER_TEMPLATE
+template <typename FnTy>
+void PAGE_FRONTIER::for_each(FnTy fn) const
+{
+	if (dense.load(std::memory_order_relaxed)) {
+		for_each_in_pages(0, block_page.size(), fn);
+		return;
+	}
+	for (const auto& queue : queues)
+		for (const entry& e : queue)
+			fn(e.page_id, e.slot_offset);
+}
+
+PAGE_FRONTIER_TEMPLATE
+template <typename FnTy>
+void PAGE_FRONTIER::for_each_active_page(FnTy fn) const
+{
+	for (std::size_t pid = 0; pid < block_page.size(); ++pid)
+		if (num_slots[pid] > 0 && 0 != summary[pid].load(std::memory_order_relaxed))
+			fn(static_cast<page_id_t>(pid));
+}
+
+PAGE_FRONTIER_TEMPLATE
+std::vector<typename PAGE_FRONTIER::entry> PAGE_FRONTIER::to_sparse() const
+{
+	std::vector<entry> entries;
+	entries.reserve(size());
+	for_each([&](page_id_t page_id, slot_offset_t slot_offset) { entries.push_back(entry{ page_id, slot_offset }); });
+	if (!dense.load(std::memory_order_relaxed)) {
+		std::sort(entries.begin(), entries.end(), [](const entry& lhs, const entry& rhs) {
+			return (lhs.page_id < rhs.page_id) || ((lhs.page_id == rhs.page_id) && (lhs.slot_offset < rhs.slot_offset));
+		});
+	}
+	return entries;
+}
+
+PAGE_FRONTIER_TEMPLATE
+void PAGE_FRONTIER::swap(page_frontier& other)
+{
+	word_base.swap(other.word_base);
+	num_slots.swap(other.num_slots);
+	block_page.swap(other.block_page);
+	std::swap(num_vertices, other.num_vertices);
+	std::swap(num_words, other.num_words);
+	words.swap(other.words);
+	summary.swap(other.summary);
+	queues.swap(other.queues);
+	std::size_t active = num_active.load(std::memory_order_relaxed);
+	num_active.store(other.num_active.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	other.num_active.store(active, std::memory_order_relaxed);
+	bool is_dense = dense.load(std::memory_order_relaxed);
+	dense.store(other.dense.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	other.dense.store(is_dense, std::memory_order_relaxed);
+	std::swap(dense_threshold, other.dense_threshold);
+}
+
+#undef PAGE_FRONTIER
+#undef PAGE_FRONTIER_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_ENGINE_FRONTIER_H_
@@ -0,0 +1,451 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/engine
+*	@file		gas_engine.h
+*	@brief		Vertex-centric (gather-apply-scatter) programs over PageDB pages
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_ENGINE_GAS_ENGINE_H_
+#define _GSTREAM_ENGINE_GAS_ENGINE_H_
+
+#include <gstream/datatype/pagedb.h>
+#include <gstream/engine/frontier.h>
+#include <gstream/engine/page_scheduler.h>
+#include <gstream/engine/page_state_array.h>
+#include <limits>
+
+/* ---------------------------------------------------------------
+**
+** Vertex program
+** The program is a template argument; its members are called
+** directly from the page loops (no virtual calls):
+**
+**   struct program {
+**       using value_t   = ...; // per-vertex state (small, trivially copyable)
+**       using message_t = ...; // what flows along an edge
+**       message_t identity() const;
+**       message_t combine(const message_t& a, const message_t& b) const;
+**       message_t gather(const value_t& source, const adj_list_elem_t& edge) const;
+**       bool      apply(value_t& value, const message_t& combined) const;
+**   };
+**
+** combine() must be commutative and associative (the combiner of
+** Pregel); gas_min/max/sum_combiner provide the common ones.
+** apply() returns true if the vertex is active in the next step.
+**
+** One step (bulk synchronous)
+** 1) gather:
+**    - push: every active vertex sends gather(value, edge) along its
+**      adjacency list; messages are combined atomically at the
+**      destination.
+**    - pull: every vertex combines gather() over the neighbours in
+**      its adjacency list which are active, in a local accumulator.
+**      The lists must be in-edges for directed semantics (an
+**      undirected or a transposed PageDB).
+** 2) apply: every vertex which received a message applies it.
+** Pages are processed as page_scheduler tasks. The adjacency list of
+** a large page (LP hub) is split into chunks over several workers;
+** the partial results of the chunks are combined atomically, so hubs
+** never serialize a step.
+**
+** Adjacency lists spilled to an overflow store (pagedb_updater,
+** pagedb_transposer) are visited when the overflow pages are given.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+enum class gas_direction_t {
+	push,
+	pull,
+};
+
+template <typename T>
+struct gas_min_combiner {
+	T identity() const
+	{
+		return std::numeric_limits<T>::max();
+	}
+	T combine(const T& a, const T& b) const
+	{
+		return (b < a) ? b : a;
+	}
+};
+
+template <typename T>
+struct gas_max_combiner {
+	T identity() const
+	{
+		return std::numeric_limits<T>::lowest();
+	}
+	T combine(const T& a, const T& b) const
+	{
+		return (a < b) ? b : a;
+	}
+};
+
+template <typename T>
+struct gas_sum_combiner {
+	T identity() const
+	{
+		return T{};
+	}
+	T combine(const T& a, const T& b) const
+	{
+		return a + b;
+	}
+};
+
+struct gas_step_stats {
+	std::size_t num_active;    // vertices active at the beginning of the step
+	std::size_t num_receivers; // vertices which received a message
+	std::size_t num_activated; // vertices active for the next step
+};
+
+template <typename PageTy, typename ProgramTy,
+	typename RIDTableTy = typename generator_traits<PageTy>::rid_table_t>
+class gas_engine {
+public:
+	using page_t = PageTy;
+	using traits_t = page_traits<page_t>;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(page_t);
+	using rid_table_t = RIDTableTy;
+	using program_t = ProgramTy;
+	using value_t = typename program_t::value_t;
+	using message_t = typename program_t::message_t;
+	using frontier_t = page_frontier<page_id_t, slot_offset_t>;
+
+	/// pages: the (base) pages of the PageDB, num_vertices: vertex ids covered by the RID table,
+	// overflow_pages: the overflow store linked by overflow_link() (nullptr: none)
+	gas_engine(page_t* pages_, const rid_table_t& rid_table_, std::size_t num_vertices_, const program_t& program_ = program_t{}, std::size_t num_threads = 0,
+		page_t* overflow_pages_ = nullptr);
+
+	/// Init: value = fn(vertex_id, out_degree) for every vertex; no vertex is active
+	template <typename FnTy>
+	void init(FnTy fn);
+	/// Activate: thread-unsafe, before a step
+	void activate(vertex_id_t vid);
+	void activate_all();
+
+	gas_step_stats step(gas_direction_t direction = gas_direction_t::push);
+	/// Run: steps until no vertex is active or max_steps is reached; returns the number of steps
+	std::size_t run(gas_direction_t direction = gas_direction_t::push, std::size_t max_steps = std::numeric_limits<std::size_t>::max());
+
+	value_t value(vertex_id_t vid) const;
+	inline page_state_array<value_t>& values()
+	{
+		return vals;
+	}
+	inline const frontier_t& frontier() const
+	{
+		return active;
+	}
+	inline program_t& program()
+	{
+		return prog;
+	}
+
+protected:
+	// Vertices of the range of the small page pid: its slots and its elided vertices (zero-degree elision, pagedb.h)
+	inline std::size_t range_size(std::size_t pid) const
+	{
+		const std::size_t end = (pid + 1 < rid_table.size()) ? static_cast<std::size_t>(rid_table[pid + 1].start_vid - rid_table[0].start_vid) : num_vertices;
+		return end - static_cast<std::size_t>(rid_table[pid].start_vid - rid_table[0].start_vid);
+	}
+	// Elements of a large-page chain member: the head page also stores the record size
+	inline std::size_t list_size(std::size_t pid, std::size_t head) const
+	{
+		return (pid == head)
+			? (pages[pid].footer.front - sizeof(record_size_t)) / sizeof(adj_list_elem_t)
+			: pages[pid].footer.front / sizeof(adj_list_elem_t);
+	}
+	// Offset in the range of the small page pid of the vertex in slot s (the slot itself unless vertices are elided)
+	inline std::size_t vertex_offset(std::size_t pid, offset_t s) const
+	{
+		return static_cast<std::size_t>(pages[pid].slot(s).vertex_id - rid_table[pid].start_vid);
+	}
+	inline adj_list_elem_t* list_of(std::size_t pid, std::size_t head) const
+	{
+		return (pid == head) ? pages[pid].list(0) : pages[pid].list_ext(0);
+	}
+	// fn(slot_offset, list, num_elems) for every list spilled from the base page pid
+	template <typename FnTy>
+	inline void for_each_spilled(std::size_t pid, FnTy fn) const
+	{
+		if (overflow_pages == nullptr)
+			return;
+		const vertex_id_t start_vid = rid_table[pid].start_vid;
+		for (uint32_t link = pages[pid].overflow_link(); link != 0; link = overflow_pages[link - 1].overflow_link()) {
+			page_t& page = overflow_pages[link - 1];
+			for (offset_t s = 0; s < page.number_of_slots(); ++s)
+				fn(static_cast<slot_offset_t>(page.slot(s).vertex_id - start_vid), page.list(s), static_cast<std::size_t>(page.record_size(s)));
+		}
+	}
+	inline void send(page_id_t pid, slot_offset_t slot, const message_t& msg, std::size_t worker)
+	{
+		auto& target = acc.at(pid, slot);
+		message_t current = target.load(std::memory_order_relaxed);
+		while (!target.compare_exchange_weak(current, prog.combine(current, msg), std::memory_order_relaxed, std::memory_order_relaxed));
+		receivers.activate(pid, slot, worker);
+	}
+
+	void push(const page_task& task, std::size_t worker);
+	void pull(const page_task& task, std::size_t worker);
+	void apply(const page_task& task, std::size_t worker);
+
+	page_t*                    pages;
+	page_t*                    overflow_pages;
+	const rid_table_t&         rid_table;
+	std::size_t                num_vertices;
+	program_t                  prog;
+	page_scheduler             scheduler;
+	std::vector<page_task>     tasks;
+	page_state_array<value_t>  vals;
+	page_state_array<message_t> acc;
+	frontier_t                 active;
+	frontier_t                 receivers;
+	frontier_t                 next;
+};
+
+#define GAS_ENGINE_TEMPLATE template <typename PageTy, typename ProgramTy, typename RIDTableTy>
+#define GAS_ENGINE gas_engine<PageTy, ProgramTy, RIDTableTy>
+
+GAS_ENGINE_TEMPLATE
+GAS_ENGINE::gas_engine(page_t* pages_, const rid_table_t& rid_table_, std::size_t num_vertices_, const program_t& program_, std::size_t num_threads, page_t* overflow_pages_) :
+	pages{ pages_ },
+	overflow_pages{ overflow_pages_ },
+	rid_table{ rid_table_ },
+	num_vertices{ num_vertices_ },
+	prog{ program_ },
+	scheduler{ num_threads },
+	tasks{ scheduler.make_tasks(rid_table_) },
+	vals{ rid_table_, num_vertices_, value_t{}, page_state_layout_t::page_aligned },
+	acc{ rid_table_, num_vertices_, program_.identity(), page_state_layout_t::page_aligned },
+	active{ rid_table_, num_vertices_, scheduler.number_of_threads() },
+	receivers{ rid_table_, num_vertices_, scheduler.number_of_threads() },
+	next{ rid_table_, num_vertices_, scheduler.number_of_threads() }
+{
+}
+
+GAS_ENGINE_TEMPLATE
+template <typename FnTy>
+void GAS_ENGINE::init(FnTy fn)
+{
+	scheduler.run_tasks(tasks, [&](const page_task& task, std::size_t) {
+		if (task.is_lp()) {
+			if (task.first_page == task.head_page) {
+				std::size_t degree = pages[task.head_page].record_size(0);
+				this->for_each_spilled(task.head_page, [&](slot_offset_t, const adj_list_elem_t*, std::size_t n) { degree += n; });
+				vals.store(task.head_page, 0, fn(rid_table[task.head_page].start_vid, degree));
+			}
+			return;
+		}
+		std::vector<std::size_t> degrees; // per vertex of the range; 0 for an elided vertex
+		for (std::size_t pid = task.first_page; pid < task.last_page; ++pid) {
+			page_t& page = pages[pid];
+			const std::size_t num_slots = page.number_of_slots();
+			degrees.assign(range_size(pid), 0);
+			for (std::size_t s = 0; s < num_slots; ++s)
+				degrees[vertex_offset(pid, static_cast<offset_t>(s))] = page.record_size(static_cast<offset_t>(s));
+			this->for_each_spilled(pid, [&](slot_offset_t slot, const adj_list_elem_t*, std::size_t n) { degrees[slot] += n; });
+			for (std::size_t v = 0; v < degrees.size(); ++v)
+				vals.store(pid, v, fn(static_cast<vertex_id_t>(rid_table[pid].start_vid + v), degrees[v]));
+		}
+	});
+	active.clear();
+}
+
+GAS_ENGINE_TEMPLATE
+void GAS_ENGINE::activate(vertex_id_t vid)
+{
+	auto loc = find_vertex_page<page_t>(vid, rid_table);
+	active.activate(loc.first, loc.second);
+}
+
+GAS_ENGINE_TEMPLATE
+void GAS_ENGINE::activate_all()
+{
+	for (std::size_t pid = 0; pid < rid_table.size(); ++pid) {
+		if (rid_table[pid].auxiliary != 0) {
+			if (pid == 0 || rid_table[pid].start_vid != rid_table[pid - 1].start_vid)
+				active.activate(static_cast<page_id_t>(pid), 0); // LP head
+			continue;
+		}
+		const std::size_t range = range_size(pid); // the elided vertices as well
+		for (std::size_t s = 0; s < range; ++s)
+			active.activate(static_cast<page_id_t>(pid), static_cast<slot_offset_t>(s));
+	}
+}
+
+GAS_ENGINE_TEMPLATE
+void GAS_ENGINE::push(const page_task& task, std::size_t worker)
+{
+	if (task.is_lp()) {
+		const page_id_t head = static_cast<page_id_t>(task.head_page);
+		if (!active.is_active(head, 0))
+			return;
+		const value_t source = vals.load(head, 0);
+		for (std::size_t pid = task.first_page; pid < task.last_page; ++pid) {
+			const adj_list_elem_t* list = list_of(pid, task.head_page);
+			const std::size_t n = list_size(pid, task.head_page);
+			for (std::size_t i = 0; i < n; ++i)
+				send(list[i].page_id, list[i].slot_offset, prog.gather(source, list[i]), worker);
+		}
+		if (task.first_page == task.head_page) {
+			for_each_spilled(head, [&](slot_offset_t, const adj_list_elem_t* list, std::size_t n) {
+				for (std::size_t i = 0; i < n; ++i)
+					this->send(list[i].page_id, list[i].slot_offset, prog.gather(source, list[i]), worker);
+			});
+		}
+		return;
+	}
+	active.for_each_in_pages(task.first_page, task.last_page, [&](page_id_t pid, slot_offset_t slot) {
+		page_t& page = pages[pid];
+		const offset_t s = page.slot_of(slot);
+		if (s >= page.number_of_slots())
+			return; // an elided zero-degree vertex: nothing to send
+		const value_t source = vals.load(pid, slot);
+		const adj_list_elem_t* list = page.list(s);
+		const std::size_t n = page.record_size(s);
+		for (std::size_t i = 0; i < n; ++i)
+			send(list[i].page_id, list[i].slot_offset, prog.gather(source, list[i]), worker);
+	});
+	for (std::size_t pid = task.first_page; pid < task.last_page; ++pid) {
+		for_each_spilled(pid, [&](slot_offset_t slot, const adj_list_elem_t* list, std::size_t n) {
+			if (!active.is_active(static_cast<page_id_t>(pid), slot))
+				return;
+			const value_t source = vals.load(pid, slot);
+			for (std::size_t i = 0; i < n; ++i)
+				this->send(list[i].page_id, list[i].slot_offset, prog.gather(source, list[i]), worker);
+		});
+	}
+}
+
+GAS_ENGINE_TEMPLATE
+void GAS_ENGINE::pull(const page_task& task, std::size_t worker)
+{
+	if (task.is_lp()) {
+		// A chunk of a hub: combine the partial result into the accumulator of the head
+		message_t partial = prog.identity();
+		bool received = false;
+		for (std::size_t pid = task.first_page; pid < task.last_page; ++pid) {
+			const adj_list_elem_t* list = list_of(pid, task.head_page);
+			const std::size_t n = list_size(pid, task.head_page);
+			for (std::size_t i = 0; i < n; ++i) {
+				if (!active.is_active(list[i].page_id, list[i].slot_offset))
+					continue;
+				partial = prog.combine(partial, prog.gather(vals.load(list[i].page_id, list[i].slot_offset), list[i]));
+				received = true;
+			}
+		}
+		if (task.first_page == task.head_page) {
+			for_each_spilled(task.head_page, [&](slot_offset_t, const adj_list_elem_t* list, std::size_t n) {
+				for (std::size_t i = 0; i < n; ++i) {
+					if (!active.is_active(list[i].page_id, list[i].slot_offset))
+						continue;
+					partial = prog.combine(partial, prog.gather(vals.load(list[i].page_id, list[i].slot_offset), list[i]));
+					received = true;
+				}
+			});
+		}
+		if (received)
+			send(static_cast<page_id_t>(task.head_page), 0, partial, worker);
+		return;
+	}
+	for (std::size_t pid = task.first_page; pid < task.last_page; ++pid) {
+		page_t& page = pages[pid];
+		const std::size_t num_slots = page.number_of_slots();
+		for (std::size_t s = 0; s < num_slots; ++s) {
+			const adj_list_elem_t* list = page.list(static_cast<offset_t>(s));
+			const std::size_t n = page.record_size(static_cast<offset_t>(s));
+			message_t sum = prog.identity();
+			bool received = false;
+			for (std::size_t i = 0; i < n; ++i) {
+				if (!active.is_active(list[i].page_id, list[i].slot_offset))
+					continue;
+				sum = prog.combine(sum, prog.gather(vals.load(list[i].page_id, list[i].slot_offset), list[i]));
+				received = true;
+			}
+			if (received) {
+				// The vertex is owned by this task: no atomic combine needed
+				const std::size_t v = vertex_offset(pid, static_cast<offset_t>(s));
+				acc.store(static_cast<page_id_t>(pid), v, sum);
+				receivers.activate(static_cast<page_id_t>(pid), static_cast<slot_offset_t>(v), worker);
+			}
+		}
+		// Spilled parts of the lists: combined on top of the stored sums
+		for_each_spilled(pid, [&](slot_offset_t slot, const adj_list_elem_t* list, std::size_t n) {
+			message_t sum = prog.identity();
+			bool received = false;
+			for (std::size_t i = 0; i < n; ++i) {
+				if (!active.is_active(list[i].page_id, list[i].slot_offset))
+					continue;
+				sum = prog.combine(sum, prog.gather(vals.load(list[i].page_id, list[i].slot_offset), list[i]));
+				received = true;
+			}
+			if (received)
+				this->send(static_cast<page_id_t>(pid), slot, sum, worker);
+		});
+	}
+}
+
+GAS_ENGINE_TEMPLATE
+void GAS_ENGINE::apply(const page_task& task, std::size_t worker)
+{
+	if (task.is_lp() && task.first_page != task.head_page)
+		return; // the vertex of a chain is applied once, by the task of the head page
+	const std::size_t last_page = task.is_lp() ? (task.head_page + 1) : task.last_page;
+	const message_t identity = prog.identity();
+	receivers.for_each_in_pages(task.first_page, last_page, [&](page_id_t pid, slot_offset_t slot) {
+		value_t value = vals.load(pid, slot);
+		const message_t msg = acc.load(pid, slot);
+		acc.store(pid, slot, identity);
+		if (prog.apply(value, msg))
+			next.activate(pid, slot, worker);
+		vals.store(pid, slot, value);
+	});
+}
+
+GAS_ENGINE_TEMPLATE
+gas_step_stats GAS_ENGINE::step(gas_direction_t direction)
+{
+	gas_step_stats stats{ active.size(), 0, 0 };
+	if (direction == gas_direction_t::push)
+		scheduler.run_tasks(tasks, [this](const page_task& task, std::size_t worker) { this->push(task, worker); });
+	else
+		scheduler.run_tasks(tasks, [this](const page_task& task, std::size_t worker) { this->pull(task, worker); });
+	stats.num_receivers = receivers.size();
+	scheduler.run_tasks(tasks, [this](const page_task& task, std::size_t worker) { this->apply(task, worker); });
+	stats.num_activated = next.size();
+	active.swap(next);
+	next.clear();
+	receivers.clear();
+	return stats;
+}
+
+GAS_ENGINE_TEMPLATE
+std::size_t GAS_ENGINE::run(gas_direction_t direction, std::size_t max_steps)
+{
+	std::size_t steps = 0;
+	while (steps < max_steps && !active.empty()) {
+		step(direction);
+		++steps;
+	}
+	return steps;
+}
+
+GAS_ENGINE_TEMPLATE
+typename GAS_ENGINE::value_t GAS_ENGINE::value(vertex_id_t vid) const
+{
+	auto loc = find_vertex_page<page_t>(vid, rid_table);
+	return vals.load(loc.first, loc.second);
+}
+
+#undef GAS_ENGINE
+#undef GAS_ENGINE_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_ENGINE_GAS_ENGINE_H_
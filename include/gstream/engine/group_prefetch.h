@@ -0,0 +1,185 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/engine
+*	@file		group_prefetch.h
+*	@brief		Group-prefetched neighbour lookups and BFS for random traversals
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_ENGINE_GROUP_PREFETCH_H_
+#define _GSTREAM_ENGINE_GROUP_PREFETCH_H_
+
+#include <gstream/datatype/neighbor_range.h>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#if _WIN32 || _WIN64
+#include <xmmintrin.h>
+#endif
+
+/* ---------------------------------------------------------------
+**
+** Group prefetching
+** Following an adj_list_elem_t {page_id, slot_offset} is a chain of
+** dependent loads: the slot of the target page, then the adjacency
+** list at slot.record_offset. In a random traversal every step of
+** the chain misses the cache, one after the other.
+** A lookup batch is processed in groups of GroupSize targets, stage
+** by stage:
+**     stage 1: prefetch the slot (and the footer) of every target
+**     stage 2: read the slots, prefetch the first line of every list
+**     stage 3: visit the lists
+** so that the misses of a group are in flight together instead of
+** serialized (the memory-level parallelism of the core is used).
+** A stage touches lines that the previous stage prefetched GroupSize
+** targets ago, which hides most of the latency for GroupSize ~ 8-32.
+**
+** group_neighbor_lookup: neighbour ranges of a batch of targets
+** group_prefetch_bfs:    level-synchronous BFS; the frontier is the
+**                        batch, and the level checks of the edges
+**                        are grouped the same way (prefetch the
+**                        levels of a group of edges, then check)
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+inline void prefetch_read(const void* addr)
+{
+#if _WIN32 || _WIN64
+	_mm_prefetch(static_cast<const char*>(addr), _MM_HINT_T0);
+#else
+	__builtin_prefetch(addr, 0, 3);
+#endif
+}
+
+inline void prefetch_write(const void* addr)
+{
+#if _WIN32 || _WIN64
+	_mm_prefetch(static_cast<const char*>(addr), _MM_HINT_T0);
+#else
+	__builtin_prefetch(addr, 1, 3);
+#endif
+}
+
+template <typename PageStoreTy, std::size_t GroupSize = 16>
+class group_neighbor_lookup {
+public:
+	using page_t = typename page_store_traits<PageStoreTy>::page_t;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(page_t);
+	using range_t = neighbor_range<PageStoreTy>;
+	static_assert(GroupSize > 0, "GroupSize must be positive");
+
+	/// overflow_pages: the overflow store linked by overflow_link() (nullptr: none)
+	explicit group_neighbor_lookup(PageStoreTy& store_, page_t* overflow_pages_ = nullptr) :
+		store(store_),
+		overflow_pages(overflow_pages_)
+	{
+	}
+
+	/// For each: fn(i, neighbor_range) for targets[0..n), in order;
+	// TargetTy has page_id and slot_offset members (adj_list_elem_t, vertex_index_entry)
+	template <typename TargetTy, typename FnTy>
+	void for_each(const TargetTy* targets, std::size_t n, FnTy fn) const;
+
+protected:
+	PageStoreTy& store;
+	page_t*      overflow_pages;
+};
+
+template <typename PageStoreTy, std::size_t GroupSize>
+template <typename TargetTy, typename FnTy>
+void group_neighbor_lookup<PageStoreTy, GroupSize>::for_each(const TargetTy* targets, std::size_t n, FnTy fn) const
+{
+	page_t* group[GroupSize];
+	for (std::size_t base = 0; base < n; base += GroupSize) {
+		std::size_t count = n - base;
+		if (count > GroupSize)
+			count = GroupSize;
+		// Stage 1: the slots and the footers (flags) of the target pages
+		for (std::size_t j = 0; j < count; ++j) {
+			page_t& page = store[targets[base + j].page_id];
+			group[j] = &page;
+			prefetch_read(&page.slot(static_cast<offset_t>(targets[base + j].slot_offset)));
+			prefetch_read(&page.footer);
+		}
+		// Stage 2: the first line of the lists (an elided zero-degree vertex has no slot to read)
+		for (std::size_t j = 0; j < count; ++j) {
+			const offset_t slot = group[j]->is_lp_head() ? 0 : group[j]->slot_of(targets[base + j].slot_offset);
+			if (group[j]->is_lp_head() || slot < group[j]->number_of_slots())
+				prefetch_read(group[j]->list(slot));
+		}
+		// Stage 3: visit
+		for (std::size_t j = 0; j < count; ++j)
+			fn(base + j, range_t{ store, targets[base + j].page_id, targets[base + j].slot_offset, overflow_pages });
+	}
+}
+
+/// Group prefetch BFS: levels[vid - first_vid] = hops from the source (unreached: max()); returns the number of levels
+// source_page/source_slot: the location of the source (vertex_index, find_vertex_page)
+template <std::size_t GroupSize = 16, typename PageStoreTy, typename RIDTableTy, typename LevelTy>
+std::size_t group_prefetch_bfs(PageStoreTy& store, const RIDTableTy& rid_table, std::size_t num_vertices,
+	typename page_store_traits<PageStoreTy>::page_t::page_id_t source_page, typename page_store_traits<PageStoreTy>::page_t::slot_offset_t source_slot,
+	std::vector<LevelTy>& levels, typename page_store_traits<PageStoreTy>::page_t* overflow_pages = nullptr)
+{
+	using page_t = typename page_store_traits<PageStoreTy>::page_t;
+	using adj_list_elem_t = typename page_t::adj_list_elem_t;
+	// Edges whose levels are prefetched together before they are checked
+	constexpr std::size_t EdgeGroupSize = 4 * GroupSize;
+	const LevelTy unreached = std::numeric_limits<LevelTy>::max();
+	levels.assign(num_vertices, unreached);
+	if (rid_table.size() == 0 || num_vertices == 0)
+		return 0;
+	const auto first_vid = rid_table[0].start_vid;
+	auto index_of = [&](const adj_list_elem_t& e) {
+		return static_cast<std::size_t>(rid_table[e.page_id].start_vid + e.slot_offset - first_vid);
+	};
+
+	std::vector<adj_list_elem_t> frontier, next;
+	std::vector<std::size_t> edges; // level indices of the pending edges
+	std::vector<adj_list_elem_t> edge_targets;
+	adj_list_elem_t source;
+	source.page_id = source_page;
+	source.slot_offset = source_slot;
+	levels[index_of(source)] = 0;
+	frontier.push_back(source);
+
+	group_neighbor_lookup<PageStoreTy, GroupSize> lookup{ store, overflow_pages };
+	std::size_t num_levels = 1;
+	for (LevelTy level = 1; !frontier.empty(); ++level) {
+		next.clear();
+		// The level checks are grouped as well: prefetch the levels of a group of edges, then check them
+		auto flush = [&]() {
+			for (std::size_t i = 0; i < edges.size(); ++i) {
+				LevelTy& target = levels[edges[i]];
+				if (target != unreached)
+					continue;
+				target = level;
+				next.push_back(edge_targets[i]);
+			}
+			edges.clear();
+			edge_targets.clear();
+		};
+		lookup.for_each(frontier.data(), frontier.size(), [&](std::size_t, const neighbor_range<PageStoreTy>& neighbors) {
+			for (const adj_list_elem_t& elem : neighbors) {
+				const std::size_t index = index_of(elem);
+				prefetch_write(&levels[index]);
+				edges.push_back(index);
+				edge_targets.push_back(elem);
+			}
+			if (edges.size() >= EdgeGroupSize)
+				flush();
+		});
+		flush();
+		if (!next.empty())
+			++num_levels;
+		frontier.swap(next);
+	}
+	return num_levels;
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_ENGINE_GROUP_PREFETCH_H_
@@ -0,0 +1,303 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/engine
+*	@file		neighbor_query.h
+*	@brief		Batched neighbour queries and k-hop expansion over a page store
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_ENGINE_NEIGHBOR_QUERY_H_
+#define _GSTREAM_ENGINE_NEIGHBOR_QUERY_H_
+
+#include <gstream/datatype/pagedb.h>
+#include <gstream/datatype/vertex_index.h>
+#include <gstream/io/mapped_page_store.h>
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** neighbor_query_service
+** Answers "neighbours of these vertices" for a batch of vertex ids:
+** 1) every vertex is located with the vertex index (O(1))
+** 2) the batch is sorted by (page, slot), so that every page (or
+**    large-page chain) is visited once per batch whatever the number
+**    of queried vertices it holds, in ascending page order
+** 3) the page ranges of the batch are coalesced and handed to
+**    prefetch_pages() before the visit: with a mapped_page_store the
+**    reads of the whole batch are in flight at once instead of one
+**    page fault per query
+** 4) the answer is a list of spans into the pages (no copy): one per
+**    chain page for an LP vertex, plus one per spilled list of the
+**    overflow store (pagedb_updater)
+**
+** k_hop() expands a seed set hop by hop with one batched query per
+** hop; a vertex is reported once, at the first hop that reaches it.
+**
+** The service does not modify its state while answering: threads
+** may share one service, each with its own result objects.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+template <typename ElemTy>
+struct neighbor_span {
+	const ElemTy* elems;
+	std::size_t   count;
+	inline const ElemTy* begin() const
+	{
+		return elems;
+	}
+	inline const ElemTy* end() const
+	{
+		return elems + count;
+	}
+	inline std::size_t size() const
+	{
+		return count;
+	}
+};
+
+struct neighbor_query_stats {
+	std::size_t num_queries;
+	std::size_t num_found; // queries whose vertex is in the index
+	std::size_t num_pages; // distinct pages (LP: chains) visited
+	std::size_t num_spans;
+};
+
+template <typename PageTy, typename PageStoreTy = mapped_page_store<PageTy>,
+	typename RIDTableTy = typename generator_traits<PageTy>::rid_table_t>
+class neighbor_query_service {
+public:
+	using page_t = PageTy;
+	using traits_t = page_traits<page_t>;
+	ALIAS_SLOTTED_PAGE_TEMPLATE_TYPEDEFS(page_t);
+	using page_store_t = PageStoreTy;
+	using rid_table_t = RIDTableTy;
+	using vertex_index_t = vertex_index<vertex_id_t, page_id_t, slot_offset_t>;
+	using span_t = neighbor_span<adj_list_elem_t>;
+
+	struct query_result {
+		/// spans of query i: spans[offsets[i]] .. spans[offsets[i + 1] - 1]
+		std::vector<span_t>      spans;
+		std::vector<std::size_t> offsets;
+		neighbor_query_stats     stats;
+
+		inline std::size_t degree(std::size_t i) const
+		{
+			std::size_t n = 0;
+			for (std::size_t s = offsets[i]; s < offsets[i + 1]; ++s)
+				n += spans[s].count;
+			return n;
+		}
+
+		// Scratch, kept to reuse its capacity across batches
+		struct order_entry {
+			page_id_t     page_id;
+			slot_offset_t slot_offset;
+			std::size_t   query;
+		};
+		std::vector<order_entry>                    order;
+		std::vector<std::pair<std::size_t, span_t>> pending; // (query, span) in visit order
+	};
+
+	struct khop_result {
+		/// vertices first reached at hop h: vertices[hop_offsets[h]] .. vertices[hop_offsets[h + 1] - 1] (ascending)
+		std::vector<vertex_id_t> vertices;
+		std::vector<std::size_t> hop_offsets;
+		query_result             query; // scratch
+	};
+
+	/// overflow_pages: the overflow store linked by overflow_link() (nullptr: none)
+	neighbor_query_service(page_store_t& store_, const rid_table_t& rid_table_, const vertex_index_t& index_, const page_t* overflow_pages_ = nullptr) :
+		store(store_),
+		rid_table(rid_table_),
+		index(index_),
+		overflow_pages(const_cast<page_t*>(overflow_pages_))
+	{
+	}
+
+	/// Query: the neighbour spans of vids[0..n); a vertex which is not in the index has none
+	void query(const vertex_id_t* vids, std::size_t n, query_result& out) const;
+	/// K-hop: hop 0 holds the (deduplicated, indexed) seeds, hop h the vertices at distance h; stops early when a hop is empty
+	void k_hop(const vertex_id_t* seeds, std::size_t n, std::size_t hops, khop_result& out) const;
+
+	/// Vertex of an adjacency list element
+	inline vertex_id_t vertex_of(const adj_list_elem_t& elem) const
+	{
+		return static_cast<vertex_id_t>(rid_table[elem.page_id].start_vid + elem.slot_offset);
+	}
+
+protected:
+	// Pages of the chain starting at head (1 for a small page)
+	inline std::size_t chain_length(std::size_t head, bool is_lp) const
+	{
+		return is_lp ? 1 + static_cast<std::size_t>(rid_table[head].auxiliary) : 1;
+	}
+	void prefetch(const query_result& out) const;
+
+	page_store_t&          store;
+	const rid_table_t&     rid_table;
+	const vertex_index_t&  index;
+	page_t*                overflow_pages;
+};
+
+#define NEIGHBOR_QUERY_SERVICE_TEMPLATE template <typename PageTy, typename PageStoreTy, typename RIDTableTy>
+#define NEIGHBOR_QUERY_SERVICE neighbor_query_service<PageTy, PageStoreTy, RIDTableTy>
+
+NEIGHBOR_QUERY_SERVICE_TEMPLATE
+void NEIGHBOR_QUERY_SERVICE::prefetch(const query_result& out) const
+{
+	std::size_t range_first = 0, range_end = 0;
+	for (std::size_t i = 0; i < out.order.size(); ++i) {
+		const std::size_t pid = out.order[i].page_id;
+		if (i > 0 && pid == out.order[i - 1].page_id)
+			continue;
+		const std::size_t end = pid + chain_length(pid, rid_table[pid].auxiliary != 0);
+		if (range_end != 0 && pid <= range_end) {
+			if (end > range_end)
+				range_end = end;
+			continue;
+		}
+		if (range_end != 0)
+			prefetch_pages(store, range_first, range_end - range_first);
+		range_first = pid;
+		range_end = end;
+	}
+	if (range_end != 0)
+		prefetch_pages(store, range_first, range_end - range_first);
+}
+
+NEIGHBOR_QUERY_SERVICE_TEMPLATE
+void NEIGHBOR_QUERY_SERVICE::query(const vertex_id_t* vids, std::size_t n, query_result& out) const
+{
+	using order_entry = typename query_result::order_entry;
+	out.spans.clear();
+	out.offsets.assign(n + 1, 0);
+	out.order.clear();
+	out.pending.clear();
+	out.stats = neighbor_query_stats{ n, 0, 0, 0 };
+
+	for (std::size_t i = 0; i < n; ++i) {
+		if (!index.contains(vids[i]))
+			continue;
+		const auto& entry = index[vids[i]];
+		out.order.push_back(order_entry{ entry.page_id, entry.slot_offset, i });
+	}
+	out.stats.num_found = out.order.size();
+	std::sort(out.order.begin(), out.order.end(), [](const order_entry& a, const order_entry& b) {
+		if (a.page_id != b.page_id)
+			return a.page_id < b.page_id;
+		if (a.slot_offset != b.slot_offset)
+			return a.slot_offset < b.slot_offset;
+		return a.query < b.query;
+	});
+	this->prefetch(out);
+
+	auto emit = [&](std::size_t first, std::size_t last, const adj_list_elem_t* elems, std::size_t count) {
+		if (count == 0)
+			return;
+		for (std::size_t q = first; q < last; ++q)
+			out.pending.emplace_back(out.order[q].query, span_t{ elems, count });
+	};
+
+	for (std::size_t group = 0; group < out.order.size();) {
+		const std::size_t pid = out.order[group].page_id;
+		std::size_t group_end = group + 1;
+		while (group_end < out.order.size() && out.order[group_end].page_id == pid)
+			++group_end;
+		++out.stats.num_pages;
+		page_t& page = store[pid];
+
+		if (page.is_lp_head()) {
+			// Every query of the group asks for the hub: one span per chain page
+			const std::size_t length = chain_length(pid, true);
+			emit(group, group_end, page.list(0), (page.footer.front - sizeof(record_size_t)) / sizeof(adj_list_elem_t));
+			for (std::size_t ext = pid + 1; ext < pid + length; ++ext) {
+				page_t& ext_page = store[ext];
+				emit(group, group_end, ext_page.list_ext(0), ext_page.footer.front / sizeof(adj_list_elem_t));
+			}
+		}
+		else {
+			for (std::size_t q = group; q < group_end;) {
+				const slot_offset_t slot = out.order[q].slot_offset;
+				std::size_t q_end = q + 1;
+				while (q_end < group_end && out.order[q_end].slot_offset == slot)
+					++q_end;
+				const offset_t s = page.slot_of(slot);
+				if (s < page.number_of_slots()) // else an elided vertex (zero-degree elision): no list
+					emit(q, q_end, page.list(s), static_cast<std::size_t>(page.record_size(s)));
+				q = q_end;
+			}
+		}
+
+		// Spilled lists: the overflow chain of the page is walked once for the whole group
+		if (overflow_pages != nullptr) {
+			const vertex_id_t start_vid = rid_table[pid].start_vid;
+			for (uint32_t link = page.overflow_link(); link != 0; link = overflow_pages[link - 1].overflow_link()) {
+				page_t& spill = overflow_pages[link - 1];
+				for (offset_t s = 0; s < spill.number_of_slots(); ++s) {
+					const slot_offset_t owner = static_cast<slot_offset_t>(spill.slot(s).vertex_id - start_vid);
+					auto first = std::lower_bound(out.order.begin() + group, out.order.begin() + group_end, owner,
+						[](const order_entry& e, slot_offset_t slot) { return e.slot_offset < slot; });
+					std::size_t q = static_cast<std::size_t>(first - out.order.begin()), q_end = q;
+					while (q_end < group_end && out.order[q_end].slot_offset == owner)
+						++q_end;
+					emit(q, q_end, spill.list(s), static_cast<std::size_t>(spill.record_size(s)));
+				}
+			}
+		}
+		group = group_end;
+	}
+
+	// Scatter the spans to the queries (stable: chain order, then overflow order)
+	for (const auto& p : out.pending)
+		++out.offsets[p.first + 1];
+	for (std::size_t i = 0; i < n; ++i)
+		out.offsets[i + 1] += out.offsets[i];
+	out.spans.resize(out.pending.size());
+	std::vector<std::size_t> cursor(out.offsets.begin(), out.offsets.end() - 1);
+	for (const auto& p : out.pending)
+		out.spans[cursor[p.first]++] = p.second;
+	out.stats.num_spans = out.spans.size();
+}
+
+NEIGHBOR_QUERY_SERVICE_TEMPLATE
+void NEIGHBOR_QUERY_SERVICE::k_hop(const vertex_id_t* seeds, std::size_t n, std::size_t hops, khop_result& out) const
+{
+	out.vertices.clear();
+	out.hop_offsets.assign(1, 0);
+	std::unordered_set<vertex_id_t> visited;
+	for (std::size_t i = 0; i < n; ++i)
+		if (index.contains(seeds[i]) && visited.insert(seeds[i]).second)
+			out.vertices.push_back(seeds[i]);
+	std::sort(out.vertices.begin(), out.vertices.end());
+	out.hop_offsets.push_back(out.vertices.size());
+
+	for (std::size_t hop = 1; hop <= hops; ++hop) {
+		const std::size_t first = out.hop_offsets[hop - 1], last = out.hop_offsets[hop];
+		if (first == last)
+			break;
+		// The frontier is copied: the vertex array grows while the spans are read
+		const std::vector<vertex_id_t> frontier(out.vertices.begin() + first, out.vertices.begin() + last);
+		query(frontier.data(), frontier.size(), out.query);
+		for (const span_t& span : out.query.spans)
+			for (const adj_list_elem_t& elem : span) {
+				const vertex_id_t v = vertex_of(elem);
+				if (visited.insert(v).second)
+					out.vertices.push_back(v);
+			}
+		std::sort(out.vertices.begin() + last, out.vertices.end());
+		out.hop_offsets.push_back(out.vertices.size());
+	}
+}
+
+#undef NEIGHBOR_QUERY_SERVICE
+#undef NEIGHBOR_QUERY_SERVICE_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_ENGINE_NEIGHBOR_QUERY_H_
@@ -0,0 +1,172 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/engine
+*	@file		page_activity.h
+*	@brief		Per-page activity tracking and coalesced read lists
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_ENGINE_PAGE_ACTIVITY_H_
+#define _GSTREAM_ENGINE_PAGE_ACTIVITY_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** page_activity_tracker
+** One bit per page telling whether the page must be read in the
+** next iteration. Marking any page of a large-page chain marks the
+** whole chain, because the adjacency list of the hub spans it.
+** read_list() returns the sorted active page ids and read_ranges()
+** coalesces them into page ranges for large sequential reads;
+** max_gap_pages bridges short inactive gaps (reading a few extra
+** pages is cheaper than issuing another request).
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+struct page_range {
+	std::size_t first_page;
+	std::size_t num_pages;
+};
+
+class page_activity_tracker {
+public:
+	using word_t = std::uint64_t;
+	static constexpr std::size_t BitsPerWord = 64;
+
+	template <typename RIDTableTy>
+	explicit page_activity_tracker(const RIDTableTy& rid_table);
+	page_activity_tracker(const page_activity_tracker&) = delete;
+	page_activity_tracker& operator=(const page_activity_tracker&) = delete;
+
+	/// Mark: thread-safe; a page of a large-page chain marks the whole chain
+	void mark(std::size_t page_id);
+	/// Mark every page reported by fn(callback), e.g. frontier.for_each_active_page
+	template <typename ForEachTy>
+	void mark_all(ForEachTy for_each_page)
+	{
+		for_each_page([this](std::size_t page_id) { this->mark(page_id); });
+	}
+
+	inline bool is_active(std::size_t page_id) const
+	{
+		return 0 != (bits[page_id / BitsPerWord].load(std::memory_order_relaxed) & (word_t{ 1 } << (page_id % BitsPerWord)));
+	}
+	inline std::size_t number_of_pages() const
+	{
+		return num_pages;
+	}
+	std::size_t count() const;
+	void clear();
+
+	/// Sorted ids of the active pages
+	std::vector<std::size_t> read_list() const;
+	/// Active pages coalesced into ranges; gaps of up to max_gap_pages inactive pages are read through,
+	// ranges are cut at max_range_pages (0: unlimited)
+	std::vector<page_range> read_ranges(std::size_t max_gap_pages = 0, std::size_t max_range_pages = 0) const;
+
+protected:
+	inline void set(std::size_t page_id)
+	{
+		bits[page_id / BitsPerWord].fetch_or(word_t{ 1 } << (page_id % BitsPerWord), std::memory_order_relaxed);
+	}
+
+	std::size_t num_pages;
+	std::size_t num_words;
+	std::unique_ptr<std::atomic<word_t>[]> bits;
+	std::vector<std::size_t> chain_head; // first page of the chain of each page (itself for small pages)
+	std::vector<std::size_t> chain_size; // pages of the chain, valid for heads
+};
+
+template <typename RIDTableTy>
+page_activity_tracker::page_activity_tracker(const RIDTableTy& rid_table) :
+	num_pages{ rid_table.size() },
+	num_words{ (rid_table.size() + BitsPerWord - 1) / BitsPerWord },
+	bits{ new std::atomic<word_t>[(num_words > 0) ? num_words : 1] },
+	chain_head(rid_table.size()),
+	chain_size(rid_table.size(), 1)
+{
+	for (std::size_t i = 0; i < num_words; ++i)
+		bits[i].store(0, std::memory_order_relaxed);
+	for (std::size_t pid = 0; pid < num_pages; ++pid) {
+		if (pid > 0 && rid_table[pid].auxiliary != 0 && rid_table[pid].start_vid == rid_table[pid - 1].start_vid) {
+			chain_head[pid] = chain_head[pid - 1];
+			++chain_size[chain_head[pid]];
+		}
+		else {
+			chain_head[pid] = pid;
+		}
+	}
+}
+
+inline void page_activity_tracker::mark(std::size_t page_id)
+{
+	const std::size_t head = chain_head[page_id];
+	if (chain_size[head] == 1) {
+		set(head);
+		return;
+	}
+	if (is_active(head))
+		return; // chains are always marked as a whole
+	// The head is set last: an active head implies an active chain
+	for (std::size_t pid = head + 1; pid < head + chain_size[head]; ++pid)
+		set(pid);
+	set(head);
+}
+
+inline std::size_t page_activity_tracker::count() const
+{
+	std::size_t n = 0;
+	for (std::size_t i = 0; i < num_words; ++i) {
+		word_t word = bits[i].load(std::memory_order_relaxed);
+		for (; word; word &= word - 1)
+			++n;
+	}
+	return n;
+}
+
+inline void page_activity_tracker::clear()
+{
+	for (std::size_t i = 0; i < num_words; ++i)
+		bits[i].store(0, std::memory_order_relaxed);
+}
+
+inline std::vector<std::size_t> page_activity_tracker::read_list() const
+{
+	std::vector<std::size_t> pages;
+	for (std::size_t i = 0; i < num_words; ++i) {
+		word_t word = bits[i].load(std::memory_order_relaxed);
+		for (std::size_t bit = 0; word; ++bit, word >>= 1)
+			if (word & 1)
+				pages.push_back(i * BitsPerWord + bit);
+	}
+	return pages;
+}
+
+inline std::vector<page_range> page_activity_tracker::read_ranges(std::size_t max_gap_pages, std::size_t max_range_pages) const
+{
+	std::vector<page_range> ranges;
+	for (std::size_t page_id : read_list()) {
+		if (!ranges.empty()) {
+			page_range& last = ranges.back();
+			const std::size_t end = last.first_page + last.num_pages;
+			const std::size_t merged = page_id + 1 - last.first_page;
+			if (page_id - end <= max_gap_pages && (0 == max_range_pages || merged <= max_range_pages)) {
+				last.num_pages = merged;
+				continue;
+			}
+		}
+		ranges.push_back(page_range{ page_id, 1 });
+	}
+	return ranges;
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_ENGINE_PAGE_ACTIVITY_H_
@@ -0,0 +1,175 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/engine
+*	@file		page_scheduler.h
+*	@brief		Work-stealing page scheduler for skewed SP/LP workloads
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_ENGINE_PAGE_SCHEDULER_H_
+#define _GSTREAM_ENGINE_PAGE_SCHEDULER_H_
+
+#include <gstream/engine/chase_lev_deque.h>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** Page tasks
+** The RID table is cut into tasks of comparable cost:
+** - SP batch: up to sp_batch_pages consecutive small pages
+** - LP chunk: up to lp_chunk_pages pages of one large-page chain;
+**   long chains become several stealable chunks of the same vertex
+**   (head_page identifies the vertex, [first_page, last_page) the
+**   part of the chain to process).
+**
+** Scheduling
+** Tasks are dealt to the workers in contiguous blocks (page order is
+** kept within a worker), each worker owns a Chase-Lev deque and
+** steals from random victims once its own deque runs dry.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+struct page_task {
+	static constexpr std::size_t NoHead = static_cast<std::size_t>(-1);
+	std::size_t first_page;
+	std::size_t last_page;  // exclusive
+	std::size_t head_page;  // LP head page of the chain; NoHead for an SP batch
+	inline bool is_lp() const
+	{
+		return head_page != NoHead;
+	}
+};
+
+struct page_scheduler_stats {
+	std::size_t num_tasks;
+	std::vector<std::size_t> executed; // per worker
+	std::vector<std::size_t> stolen;   // per worker
+};
+
+class page_scheduler {
+public:
+	// num_threads = 0: std::thread::hardware_concurrency()
+	explicit page_scheduler(std::size_t num_threads_ = 0, std::size_t sp_batch_pages_ = 32, std::size_t lp_chunk_pages_ = 8) :
+		num_threads{ (num_threads_ > 0) ? num_threads_ : std::max<std::size_t>(1, std::thread::hardware_concurrency()) },
+		sp_batch_pages{ (sp_batch_pages_ > 0) ? sp_batch_pages_ : 1 },
+		lp_chunk_pages{ (lp_chunk_pages_ > 0) ? lp_chunk_pages_ : 1 }
+	{
+	}
+
+	/// Make tasks: SP batches and LP chunks over a RID table
+	template <typename RIDTableTy>
+	std::vector<page_task> make_tasks(const RIDTableTy& rid_table) const;
+
+	/// Run fn(const page_task&, worker_id) for every task of the RID table
+	template <typename RIDTableTy, typename FnTy>
+	page_scheduler_stats run(const RIDTableTy& rid_table, FnTy fn) const
+	{
+		return run_tasks(make_tasks(rid_table), fn);
+	}
+
+	template <typename FnTy>
+	page_scheduler_stats run_tasks(const std::vector<page_task>& tasks, FnTy fn) const;
+
+	inline std::size_t number_of_threads() const
+	{
+		return num_threads;
+	}
+
+protected:
+	std::size_t num_threads;
+	std::size_t sp_batch_pages;
+	std::size_t lp_chunk_pages;
+};
+
+template <typename RIDTableTy>
+std::vector<page_task> page_scheduler::make_tasks(const RIDTableTy& rid_table) const
+{
+	std::vector<page_task> tasks;
+	const std::size_t num_pages = rid_table.size();
+	std::size_t pid = 0;
+	while (pid < num_pages) {
+		if (rid_table[pid].auxiliary == 0) {
+			// SP batch: stop at the next large page
+			std::size_t last = pid;
+			while (last < num_pages && last - pid < sp_batch_pages && rid_table[last].auxiliary == 0)
+				++last;
+			tasks.push_back(page_task{ pid, last, page_task::NoHead });
+			pid = last;
+			continue;
+		}
+		// LP chain: head page + 'auxiliary' extended pages
+		const std::size_t chain_end = std::min(num_pages, pid + 1 + static_cast<std::size_t>(rid_table[pid].auxiliary));
+		for (std::size_t first = pid; first < chain_end; first += lp_chunk_pages)
+			tasks.push_back(page_task{ first, std::min(chain_end, first + lp_chunk_pages), pid });
+		pid = chain_end;
+	}
+	return tasks;
+}
+
+template <typename FnTy>
+page_scheduler_stats page_scheduler::run_tasks(const std::vector<page_task>& tasks, FnTy fn) const
+{
+	page_scheduler_stats stats{ tasks.size(), std::vector<std::size_t>(num_threads, 0), std::vector<std::size_t>(num_threads, 0) };
+	if (tasks.empty())
+		return stats;
+
+	std::vector<std::unique_ptr<chase_lev_deque<std::size_t>>> deques;
+	for (std::size_t w = 0; w < num_threads; ++w) {
+		const std::size_t first = tasks.size() * w / num_threads;
+		const std::size_t last = tasks.size() * (w + 1) / num_threads;
+		deques.emplace_back(new chase_lev_deque<std::size_t>{ last - first });
+		// Pushed in reverse: the owner pops its block in page order, thieves take the far end
+		for (std::size_t i = last; i > first; --i)
+			deques[w]->push(i - 1);
+	}
+
+	std::atomic<std::size_t> remaining{ tasks.size() };
+	auto worker = [&](std::size_t id) {
+		std::minstd_rand rng{ static_cast<std::minstd_rand::result_type>(id + 1) };
+		std::size_t task;
+		std::size_t executed = 0, stolen = 0;
+		while (remaining.load(std::memory_order_acquire) > 0) {
+			if (deques[id]->pop(task)) {
+				fn(tasks[task], id);
+				++executed;
+				remaining.fetch_sub(1, std::memory_order_acq_rel);
+				continue;
+			}
+			if (num_threads == 1)
+				break;
+			std::size_t victim = rng() % (num_threads - 1);
+			if (victim >= id)
+				++victim;
+			if (deques[victim]->steal(task) == chase_lev_deque<std::size_t>::steal_result_t::success) {
+				fn(tasks[task], id);
+				++executed;
+				++stolen;
+				remaining.fetch_sub(1, std::memory_order_acq_rel);
+			}
+			else {
+				std::this_thread::yield();
+			}
+		}
+		stats.executed[id] = executed;
+		stats.stolen[id] = stolen;
+	};
+
+	std::vector<std::thread> workers;
+	for (std::size_t id = 1; id < num_threads; ++id)
+		workers.emplace_back(worker, id);
+	worker(0);
+	for (auto& w : workers)
+		w.join();
+	return stats;
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_ENGINE_PAGE_SCHEDULER_H_
@@ -0,0 +1,206 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/engine
+*	@file		page_state_array.h
+*	@brief		Concurrent per-vertex state indexed by (page_id, slot_offset)
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_ENGINE_PAGE_STATE_ARRAY_H_
+#define _GSTREAM_ENGINE_PAGE_STATE_ARRAY_H_
+
+#include <gstream/memory/aligned_memory.h>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** page_state_array<T>
+** Per-vertex state (distance, label, rank, ...) addressed the same
+** way as an adj_list_element addresses a neighbour:
+**     state index = page_base[page_id] + slot_offset
+** page_base is precomputed from the RID table; the extended pages of
+** a large page share the base of their head page. Elements are
+** std::atomic<T> in a cache-line aligned block.
+**
+** Layout
+** - dense:      vertices are packed back to back
+** - page_aligned: every page starts on a cache line, so that workers
+**               processing different pages never write to the same
+**               cache line (no false sharing between page tasks)
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+enum class page_state_layout_t {
+	dense,
+	page_aligned,
+};
+
+template <typename T>
+class page_state_array {
+	static_assert(std::is_trivially_copyable<T>::value, "page_state_array requires a trivially copyable state type");
+public:
+	using value_t = T;
+	using atomic_t = std::atomic<T>;
+	static constexpr std::size_t CacheLineSize = 64;
+
+	/// num_vertices: the number of vertex ids covered by the RID table, starting at rid_table[0].start_vid
+	template <typename RIDTableTy>
+	page_state_array(const RIDTableTy& rid_table, std::size_t num_vertices, const T& init = T{}, page_state_layout_t layout = page_state_layout_t::dense);
+	page_state_array(const page_state_array&) = delete;
+	page_state_array& operator=(const page_state_array&) = delete;
+	~page_state_array();
+
+	inline std::size_t index(std::size_t page_id, std::size_t slot_offset) const
+	{
+		return page_base[page_id] + slot_offset;
+	}
+	inline atomic_t& at(std::size_t page_id, std::size_t slot_offset)
+	{
+		return states[index(page_id, slot_offset)];
+	}
+	// Element access by state index (e.g. index() cached by the caller)
+	inline atomic_t& operator[](std::size_t state_index)
+	{
+		return states[state_index];
+	}
+
+	inline T load(std::size_t page_id, std::size_t slot_offset, std::memory_order order = std::memory_order_relaxed) const
+	{
+		return states[index(page_id, slot_offset)].load(order);
+	}
+	inline void store(std::size_t page_id, std::size_t slot_offset, const T& value, std::memory_order order = std::memory_order_relaxed)
+	{
+		states[index(page_id, slot_offset)].store(value, order);
+	}
+
+	/// Atomic min/max: returns true if the stored value was replaced by 'value'
+	inline bool atomic_min(std::size_t page_id, std::size_t slot_offset, const T& value)
+	{
+		return update_if(at(page_id, slot_offset), value, [](const T& current, const T& desired) { return desired < current; });
+	}
+	inline bool atomic_max(std::size_t page_id, std::size_t slot_offset, const T& value)
+	{
+		return update_if(at(page_id, slot_offset), value, [](const T& current, const T& desired) { return current < desired; });
+	}
+	inline bool compare_and_swap(std::size_t page_id, std::size_t slot_offset, T expected, const T& desired)
+	{
+		return at(page_id, slot_offset).compare_exchange_strong(expected, desired, std::memory_order_acq_rel, std::memory_order_relaxed);
+	}
+	/// Fetch-add: native for integral types, CAS loop otherwise (e.g. float ranks)
+	inline T fetch_add(std::size_t page_id, std::size_t slot_offset, const T& delta)
+	{
+		static_assert(!std::is_same<T, bool>::value, "page_state_array<bool>::fetch_add: std::atomic<bool> has no fetch_add and a sum of flags is not a flag; use compare_and_swap");
+		return fetch_add_impl(at(page_id, slot_offset), delta, std::is_integral<T>{});
+	}
+
+	void fill(const T& value);
+
+	// The number of state elements (including the padding of the page_aligned layout)
+	inline std::size_t size() const
+	{
+		return num_states;
+	}
+	inline std::size_t number_of_pages() const
+	{
+		return page_base.size();
+	}
+
+protected:
+	template <typename PredTy>
+	static bool update_if(atomic_t& target, const T& value, PredTy pred)
+	{
+		T current = target.load(std::memory_order_relaxed);
+		while (pred(current, value)) {
+			if (target.compare_exchange_weak(current, value, std::memory_order_acq_rel, std::memory_order_relaxed))
+				return true;
+		}
+		return false;
+	}
+	static T fetch_add_impl(atomic_t& target, const T& delta, std::true_type)
+	{
+		return target.fetch_add(delta, std::memory_order_acq_rel);
+	}
+	static T fetch_add_impl(atomic_t& target, const T& delta, std::false_type)
+	{
+		T current = target.load(std::memory_order_relaxed);
+		while (!target.compare_exchange_weak(current, current + delta, std::memory_order_acq_rel, std::memory_order_relaxed));
+		return current;
+	}
+
+	std::vector<std::size_t> page_base;
+	std::size_t              num_states;
+	aligned_buffer_ptr       buffer;
+	atomic_t*                states;
+};
+
+#define PAGE_STATE_ARRAY_TEMPLATE template <typename T>
+#define PAGE_STATE_ARRAY page_state_array<T>
+
+PAGE_STATE_ARRAY_TEMPLATE
+template <typename RIDTableTy>
+PAGE_STATE_ARRAY::page_state_array(const RIDTableTy& rid_table, std::size_t num_vertices, const T& init, page_state_layout_t layout) :
+	num_states{ 0 },
+	states{ nullptr }
+{
+	const std::size_t num_pages = rid_table.size();
+	page_base.resize(num_pages);
+	if (num_pages > 0) {
+		const std::size_t first_vid = static_cast<std::size_t>(rid_table[0].start_vid);
+		const std::size_t states_per_line = (sizeof(atomic_t) >= CacheLineSize) ? 1 : (CacheLineSize / sizeof(atomic_t));
+		std::size_t next_base = 0;
+		for (std::size_t pid = 0; pid < num_pages; ++pid) {
+			const std::size_t start = static_cast<std::size_t>(rid_table[pid].start_vid) - first_vid;
+			if (pid > 0 && rid_table[pid].start_vid == rid_table[pid - 1].start_vid) {
+				page_base[pid] = page_base[pid - 1]; // extended page of a large page
+				continue;
+			}
+			// Slots of this page: up to the next page with a different start vertex
+			std::size_t end = num_vertices;
+			for (std::size_t next = pid + 1; next < num_pages; ++next) {
+				if (rid_table[next].start_vid != rid_table[pid].start_vid) {
+					end = static_cast<std::size_t>(rid_table[next].start_vid) - first_vid;
+					break;
+				}
+			}
+			if (layout == page_state_layout_t::page_aligned)
+				next_base = (next_base + states_per_line - 1) / states_per_line * states_per_line;
+			else
+				next_base = start;
+			page_base[pid] = next_base;
+			next_base += (end > start) ? (end - start) : 0;
+		}
+		num_states = next_base;
+	}
+
+	buffer = make_aligned_buffer(sizeof(atomic_t) * ((num_states > 0) ? num_states : 1), CacheLineSize);
+	states = reinterpret_cast<atomic_t*>(buffer.get());
+	for (std::size_t i = 0; i < num_states; ++i)
+		new (&states[i]) atomic_t(init);
+}
+
+PAGE_STATE_ARRAY_TEMPLATE
+PAGE_STATE_ARRAY::~page_state_array()
+{
+	for (std::size_t i = 0; i < num_states; ++i)
+		states[i].~atomic_t();
+}
+
+PAGE_STATE_ARRAY_TEMPLATE
+void PAGE_STATE_ARRAY::fill(const T& value)
+{
+	for (std::size_t i = 0; i < num_states; ++i)
+		states[i].store(value, std::memory_order_relaxed);
+}
+
+#undef PAGE_STATE_ARRAY
+#undef PAGE_STATE_ARRAY_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_ENGINE_PAGE_STATE_ARRAY_H_
@@ -0,0 +1,203 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/io
+*	@file		mapped_file.h
+*	@brief		Memory-mapped file (read-only or read-write)
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_IO_MAPPED_FILE_H_
+#define _GSTREAM_IO_MAPPED_FILE_H_
+
+#include <cstdint>
+#include <cstddef>
+
+#if _WIN32 || _WIN64
+#ifndef NOMINMAX
+#define NOMINMAX // std::min/std::max in the rest of the library
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* ---------------------------------------------------------------
+**
+** mapped_file
+** - open():   maps an existing file read-only (shared, so that the
+**             page cache is shared by every process mapping it)
+** - create(): creates (truncates) a file of the given size and maps
+**             it read-write; flush() writes the dirty pages back
+** The mapping is released by close() or by the destructor.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+class mapped_file {
+public:
+	mapped_file() = default;
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+	~mapped_file()
+	{
+		close();
+	}
+
+	bool open(const char* filepath);
+	bool create(const char* filepath, std::size_t size);
+	bool flush();
+	void close();
+
+	inline bool is_open() const
+	{
+		return addr != nullptr;
+	}
+	inline std::uint8_t* data() const
+	{
+		return static_cast<std::uint8_t*>(addr);
+	}
+	inline std::size_t size() const
+	{
+		return mapped_size;
+	}
+
+protected:
+	bool map(const char* filepath, std::size_t size, bool writable);
+
+	void*       addr{ nullptr };
+	std::size_t mapped_size{ 0 };
+	bool        writable{ false };
+#if _WIN32 || _WIN64
+	HANDLE      file{ INVALID_HANDLE_VALUE };
+	HANDLE      mapping{ nullptr };
+#endif
+};
+
+inline bool mapped_file::open(const char* filepath)
+{
+	return map(filepath, 0, false);
+}
+
+inline bool mapped_file::create(const char* filepath, std::size_t size)
+{
+	return map(filepath, size, true);
+}
+
+#if _WIN32 || _WIN64
+
+inline bool mapped_file::map(const char* filepath, std::size_t size, bool writable_)
+{
+	close();
+	file = CreateFileA(filepath, writable_ ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ, nullptr,
+		writable_ ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	if (!writable_) {
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file, &file_size)) {
+			close();
+			return false;
+		}
+		size = static_cast<std::size_t>(file_size.QuadPart);
+	}
+	if (size == 0) {
+		close();
+		return false;
+	}
+	const std::uint64_t size64 = static_cast<std::uint64_t>(size);
+	mapping = CreateFileMappingA(file, nullptr, writable_ ? PAGE_READWRITE : PAGE_READONLY,
+		static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFFull), nullptr);
+	if (mapping == nullptr) {
+		close();
+		return false;
+	}
+	addr = MapViewOfFile(mapping, writable_ ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+	if (addr == nullptr) {
+		close();
+		return false;
+	}
+	mapped_size = size;
+	writable = writable_;
+	return true;
+}
+
+inline bool mapped_file::flush()
+{
+	if (!addr || !writable)
+		return addr != nullptr;
+	return FlushViewOfFile(addr, mapped_size) && FlushFileBuffers(file);
+}
+
+inline void mapped_file::close()
+{
+	if (addr)
+		UnmapViewOfFile(addr);
+	if (mapping)
+		CloseHandle(mapping);
+	if (file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+	addr = nullptr;
+	mapping = nullptr;
+	file = INVALID_HANDLE_VALUE;
+	mapped_size = 0;
+	writable = false;
+}
+
+#else
+
+inline bool mapped_file::map(const char* filepath, std::size_t size, bool writable_)
+{
+	close();
+	int fd = writable_ ? ::open(filepath, O_RDWR | O_CREAT | O_TRUNC, 0644) : ::open(filepath, O_RDONLY);
+	if (fd < 0)
+		return false;
+	if (writable_) {
+		if (size == 0 || 0 != ::ftruncate(fd, static_cast<off_t>(size))) {
+			::close(fd);
+			return false;
+		}
+	}
+	else {
+		struct stat st;
+		if (0 != ::fstat(fd, &st) || st.st_size == 0) {
+			::close(fd);
+			return false;
+		}
+		size = static_cast<std::size_t>(st.st_size);
+	}
+	void* p = ::mmap(nullptr, size, writable_ ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd); // the mapping keeps the file referenced
+	if (p == MAP_FAILED)
+		return false;
+	addr = p;
+	mapped_size = size;
+	writable = writable_;
+	return true;
+}
+
+inline bool mapped_file::flush()
+{
+	if (!addr || !writable)
+		return addr != nullptr;
+	return 0 == ::msync(addr, mapped_size, MS_SYNC);
+}
+
+inline void mapped_file::close()
+{
+	if (addr)
+		::munmap(addr, mapped_size);
+	addr = nullptr;
+	mapped_size = 0;
+	writable = false;
+}
+
+#endif
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_IO_MAPPED_FILE_H_
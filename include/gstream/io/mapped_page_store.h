@@ -0,0 +1,120 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/io
+*	@file		mapped_page_store.h
+*	@brief		Read-only page store backed by a memory-mapped .pages file
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_IO_MAPPED_PAGE_STORE_H_
+#define _GSTREAM_IO_MAPPED_PAGE_STORE_H_
+
+#include <gstream/io/mapped_file.h>
+#include <cstdint>
+#include <cstddef>
+
+/* ---------------------------------------------------------------
+**
+** mapped_page_store
+** Maps a .pages file and exposes it with the same operator[] as
+** std::vector<page_t> and numa_page_store, so that the engines and
+** query services take any of the three as their page store.
+** Pages are faulted in on first access and cached by the OS; the
+** mapping is read-only, the pages must not be modified.
+**
+** prefetch_pages(store, first, n) hints that a page range is about
+** to be read: a no-op for in-memory stores, an asynchronous
+** read-ahead (madvise WILLNEED) for a mapped store.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+template <typename PageTy>
+class mapped_page_store {
+public:
+	using page_t = PageTy;
+	static constexpr std::size_t PageSize = page_t::PageSize;
+
+	mapped_page_store() = default;
+	explicit mapped_page_store(const char* filepath)
+	{
+		open(filepath);
+	}
+
+	bool open(const char* filepath)
+	{
+		if (!file.open(filepath))
+			return false;
+		num_pages = file.size() / PageSize;
+		return true;
+	}
+	void close()
+	{
+		file.close();
+		num_pages = 0;
+	}
+
+	/// Will need: starts reading [first_page, first_page + count) in the background
+	void will_need(std::size_t first_page, std::size_t count) const;
+
+	inline bool is_open() const
+	{
+		return file.is_open();
+	}
+	inline page_t& operator[](std::size_t page_id) const
+	{
+		return data()[page_id];
+	}
+	inline page_t* data() const
+	{
+		return reinterpret_cast<page_t*>(file.data());
+	}
+	inline std::size_t size() const
+	{
+		return num_pages;
+	}
+	inline std::size_t number_of_pages() const
+	{
+		return num_pages;
+	}
+
+protected:
+	mapped_file file;
+	std::size_t num_pages{ 0 };
+};
+
+template <typename PageTy>
+void mapped_page_store<PageTy>::will_need(std::size_t first_page, std::size_t count) const
+{
+	if (first_page >= num_pages || count == 0)
+		return;
+	if (count > num_pages - first_page)
+		count = num_pages - first_page;
+#if _WIN32 || _WIN64
+	// PrefetchVirtualMemory is not available before Windows 8; the pages are faulted in on access
+	(void)first_page;
+#else
+	static const std::size_t os_page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+	const std::size_t begin = first_page * PageSize;
+	const std::size_t aligned_begin = begin - (begin % os_page_size);
+	::madvise(file.data() + aligned_begin, begin + count * PageSize - aligned_begin, MADV_WILLNEED);
+#endif
+}
+
+/// Prefetch pages: no-op for in-memory page stores
+template <typename PageStoreTy>
+inline void prefetch_pages(const PageStoreTy&, std::size_t, std::size_t)
+{
+}
+
+template <typename PageTy>
+inline void prefetch_pages(const mapped_page_store<PageTy>& store, std::size_t first_page, std::size_t count)
+{
+	store.will_need(first_page, count);
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_IO_MAPPED_PAGE_STORE_H_
@@ -0,0 +1,315 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/io
+*	@file		page_writer.h
+*	@brief		Buffered, batched page output sinks for PageDB generators
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_IO_PAGE_WRITER_H_
+#define _GSTREAM_IO_PAGE_WRITER_H_
+
+#include <gstream/memory/aligned_memory.h>
+#include <functional>
+#include <ostream>
+#include <utility>
+
+#if !(_WIN32 || _WIN64)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gstream {
+
+/* ---------------------------------------------------------------
+**
+** Page sink concept
+** A sink receives large, page-aligned batches of pages from a
+** buffered_page_writer and must provide the following members:
+**   bool write(const uint8_t* data, std::size_t size); // false on failure
+**   bool sync();                                       // durability barrier
+**   bool seek(std::uint64_t offset);                   // reposition the output (resume)
+**   bool size(std::uint64_t& bytes);                   // current length of the output (resume)
+**
+** ------------------------------------------------------------ */
+
+/// Sink for a std::ostream (default sink of the PageDB generator)
+class ostream_page_sink {
+public:
+	// Called after the stream is flushed to put it on the disk, e.g. fsync on the descriptor of the file
+	using sync_hook_t = std::function<bool()>;
+
+	explicit ostream_page_sink(std::ostream& os_, sync_hook_t sync_hook_ = nullptr) :
+		os{ os_ },
+		sync_hook{ std::move(sync_hook_) }
+	{
+	}
+	bool write(const uint8_t* data, std::size_t size)
+	{
+		os.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+		return os.good();
+	}
+	// A std::ostream cannot be synced to the disk by itself: without a sync hook it is only flushed
+	bool sync()
+	{
+		os.flush();
+		if (!os.good())
+			return false;
+		return (sync_hook) ? sync_hook() : true;
+	}
+	bool seek(std::uint64_t offset)
+	{
+		os.seekp(static_cast<std::streamoff>(offset), std::ios::beg);
+		return os.good();
+	}
+	bool size(std::uint64_t& bytes)
+	{
+		std::streampos pos = os.tellp();
+		if (pos == std::streampos(-1))
+			return false;
+		os.seekp(0, std::ios::end);
+		std::streampos end = os.tellp();
+		os.seekp(pos);
+		if (end == std::streampos(-1) || !os.good())
+			return false;
+		bytes = static_cast<std::uint64_t>(static_cast<std::streamoff>(end));
+		return true;
+	}
+
+protected:
+	std::ostream& os;
+	sync_hook_t   sync_hook;
+};
+
+#if !(_WIN32 || _WIN64)
+/// Sink for a POSIX file descriptor, optionally opened with O_DIRECT to bypass the page cache.
+class fd_page_sink {
+public:
+	// Takes the ownership of the file descriptor (e.g. the previous output opened without O_TRUNC to resume)
+	explicit fd_page_sink(int fd_, bool direct_ = false) :
+		fd{ fd_ },
+		direct{ direct_ }
+	{
+	}
+	explicit fd_page_sink(const char* filepath, bool direct_ = false) :
+		fd{ open_file(filepath, direct_) },
+		direct{ direct_ }
+	{
+	}
+	fd_page_sink(const fd_page_sink&) = delete;
+	fd_page_sink& operator=(const fd_page_sink&) = delete;
+	~fd_page_sink()
+	{
+		if (fd >= 0)
+			::close(fd);
+	}
+
+	inline bool is_open() const
+	{
+		return fd >= 0;
+	}
+
+	bool write(const uint8_t* data, std::size_t size)
+	{
+		if (fd < 0)
+			return false;
+		// O_DIRECT requires the transfer size to be a multiple of the device block;
+		// the trailing batch of a PageDB may not be, so fall back to buffered I/O for it.
+		if (direct && (size % DIRECT_IO_ALIGNMENT) != 0)
+			disable_direct_io();
+		while (size > 0) {
+			ssize_t written = ::write(fd, data, size);
+			if (written < 0) {
+				if (errno == EINTR)
+					continue;
+				return false;
+			}
+			data += written;
+			size -= static_cast<std::size_t>(written);
+		}
+		return true;
+	}
+	bool sync()
+	{
+		return (fd >= 0) && (0 == ::fsync(fd));
+	}
+	bool seek(std::uint64_t offset)
+	{
+		if (fd < 0)
+			return false;
+		// Later O_DIRECT transfers would start at an unaligned file offset
+		if (direct && (offset % DIRECT_IO_ALIGNMENT) != 0)
+			disable_direct_io();
+		return ::lseek(fd, static_cast<off_t>(offset), SEEK_SET) == static_cast<off_t>(offset);
+	}
+	bool size(std::uint64_t& bytes)
+	{
+		struct stat st;
+		if (fd < 0 || 0 != ::fstat(fd, &st))
+			return false;
+		bytes = static_cast<std::uint64_t>(st.st_size);
+		return true;
+	}
+
+protected:
+	static int open_file(const char* filepath, bool direct)
+	{
+		int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#if defined(O_DIRECT)
+		if (direct)
+			flags |= O_DIRECT;
+#else
+		(void)direct;
+#endif
+		return ::open(filepath, flags, 0644);
+	}
+	void disable_direct_io()
+	{
+#if defined(O_DIRECT)
+		int flags = ::fcntl(fd, F_GETFL);
+		if (flags >= 0)
+			::fcntl(fd, F_SETFL, flags & ~O_DIRECT);
+#endif
+		direct = false;
+	}
+
+	int  fd;
+	bool direct;
+};
+#endif
+
+/* ---------------------------------------------------------------
+**
+** buffered_page_writer
+** Accumulates issued pages in a large aligned buffer and hands
+** them to the sink in a single call per batch, so that the number
+** of system calls is proportional to (#pages / pages_per_flush)
+** instead of #pages.
+**
+** ------------------------------------------------------------ */
+template <std::size_t PageSize, typename SinkTy = ostream_page_sink>
+class buffered_page_writer {
+public:
+	using sink_t = SinkTy;
+	// Default batch: 4MB worth of pages (at least one page)
+	static constexpr std::size_t DefaultPagesPerFlush = (PageSize >= (4u << 20)) ? 1u : ((4u << 20) / PageSize);
+
+	template <typename ...SinkArgs>
+	explicit buffered_page_writer(std::size_t pages_per_flush, SinkArgs&& ...sink_args);
+	buffered_page_writer(const buffered_page_writer&) = delete;
+	buffered_page_writer& operator=(const buffered_page_writer&) = delete;
+	~buffered_page_writer();
+
+	/// Write: copy a page into the buffer; the buffer is flushed when it becomes full.
+	bool write(const void* page);
+	/// Next frame: returns the next page frame of the buffer to build a page in place.
+	/// The frame is committed by a following call of commit().
+	uint8_t* next_frame();
+	bool commit();
+	/// Flush: hand all buffered pages over to the sink.
+	bool flush();
+	/// Sync: flush and ask the sink for a durability barrier.
+	bool sync();
+
+	inline sink_t& sink()
+	{
+		return out;
+	}
+	inline bool good() const
+	{
+		return !failed;
+	}
+	// The number of pages accepted by this writer (including buffered pages)
+	inline std::uint64_t number_of_pages() const
+	{
+		return num_flushed + num_buffered;
+	}
+
+protected:
+	sink_t             out;
+	aligned_buffer_ptr buffer;
+	std::size_t        capacity;
+	std::size_t        num_buffered;
+	std::uint64_t      num_flushed;
+	bool               failed;
+};
+
+#define BUFFERED_PAGE_WRITER_TEMPLATE template <std::size_t PageSize, typename SinkTy>
+#define BUFFERED_PAGE_WRITER buffered_page_writer<PageSize, SinkTy>
+
+BUFFERED_PAGE_WRITER_TEMPLATE
+template <typename ...SinkArgs>
+BUFFERED_PAGE_WRITER::buffered_page_writer(std::size_t pages_per_flush, SinkArgs&& ...sink_args) :
+	out{ std::forward<SinkArgs>(sink_args)... },
+	buffer{ make_aligned_buffer(PageSize * ((pages_per_flush > 0) ? pages_per_flush : 1)) },
+	capacity{ (pages_per_flush > 0) ? pages_per_flush : 1 },
+	num_buffered{ 0 },
+	num_flushed{ 0 },
+	failed{ !buffer }
+{
+}
+
+BUFFERED_PAGE_WRITER_TEMPLATE
+BUFFERED_PAGE_WRITER::~buffered_page_writer()
+{
+	flush();
+}
+
+BUFFERED_PAGE_WRITER_TEMPLATE
+bool BUFFERED_PAGE_WRITER::write(const void* page)
+{
+	uint8_t* frame = next_frame();
+	if (!frame)
+		return false;
+	memcpy(frame, page, PageSize);
+	return commit();
+}
+
+BUFFERED_PAGE_WRITER_TEMPLATE
+uint8_t* BUFFERED_PAGE_WRITER::next_frame()
+{
+	if (failed)
+		return nullptr;
+	return buffer.get() + (num_buffered * PageSize);
+}
+
+BUFFERED_PAGE_WRITER_TEMPLATE
+bool BUFFERED_PAGE_WRITER::commit()
+{
+	++num_buffered;
+	if (num_buffered == capacity)
+		return flush();
+	return !failed;
+}
+
+BUFFERED_PAGE_WRITER_TEMPLATE
+bool BUFFERED_PAGE_WRITER::flush()
+{
+	if (failed || num_buffered == 0)
+		return !failed;
+	if (!out.write(buffer.get(), num_buffered * PageSize))
+		failed = true;
+	num_flushed += num_buffered;
+	num_buffered = 0;
+	return !failed;
+}
+
+BUFFERED_PAGE_WRITER_TEMPLATE
+bool BUFFERED_PAGE_WRITER::sync()
+{
+	if (!flush())
+		return false;
+	if (!out.sync())
+		failed = true;
+	return !failed;
+}
+
+#undef BUFFERED_PAGE_WRITER
+#undef BUFFERED_PAGE_WRITER_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_IO_PAGE_WRITER_H_
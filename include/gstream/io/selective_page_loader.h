@@ -0,0 +1,150 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/io
+*	@file		selective_page_loader.h
+*	@brief		Reads only the active page ranges of a .pages file
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_IO_SELECTIVE_PAGE_LOADER_H_
+#define _GSTREAM_IO_SELECTIVE_PAGE_LOADER_H_
+
+#include <gstream/engine/page_activity.h>
+#include <gstream/memory/aligned_memory.h>
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+/* ---------------------------------------------------------------
+**
+** selective_page_loader
+** Streams the coalesced page ranges of a page_activity_tracker (or
+** any sorted page_range list) from a .pages file and skips the rest,
+** so that the I/O of an iteration is proportional to its active set.
+** Every range is one seek + one large read (ranges longer than the
+** staging buffer are split into buffer-sized reads).
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+struct page_load_stats {
+	std::size_t   num_reads;
+	std::size_t   num_pages_read;
+	std::uint64_t bytes_read;
+	bool          failed;
+};
+
+template <typename PageTy>
+class selective_page_loader {
+public:
+	using page_t = PageTy;
+	static constexpr std::size_t PageSize = page_t::PageSize;
+	// Default staging buffer: 4MB worth of pages (at least one page)
+	static constexpr std::size_t DefaultBatchPages = (PageSize >= (4u << 20)) ? 1u : ((4u << 20) / PageSize);
+
+	explicit selective_page_loader(const char* filepath, std::size_t batch_pages_ = DefaultBatchPages);
+
+	inline bool is_open() const
+	{
+		return ifs.is_open();
+	}
+	inline std::size_t number_of_pages() const
+	{
+		return num_pages;
+	}
+
+	/// Load: fn(first_page_id, const page_t* pages, num_pages) for every read
+	template <typename FnTy>
+	page_load_stats load(const std::vector<page_range>& ranges, FnTy fn);
+	/// Load: the active pages of a tracker
+	template <typename FnTy>
+	page_load_stats load(const page_activity_tracker& tracker, FnTy fn, std::size_t max_gap_pages = 0)
+	{
+		return load(tracker.read_ranges(max_gap_pages, batch_pages), fn);
+	}
+	/// Load into: read the ranges into a full-size page array; other pages are left untouched
+	page_load_stats load_into(const std::vector<page_range>& ranges, page_t* pages);
+
+protected:
+	bool read(std::size_t first_page, std::size_t count, void* dst, page_load_stats& stats);
+
+	std::ifstream      ifs;
+	std::size_t        num_pages;
+	std::size_t        batch_pages;
+	aligned_buffer_ptr buffer;
+};
+
+#define SELECTIVE_PAGE_LOADER_TEMPLATE template <typename PageTy>
+#define SELECTIVE_PAGE_LOADER selective_page_loader<PageTy>
+
+SELECTIVE_PAGE_LOADER_TEMPLATE
+SELECTIVE_PAGE_LOADER::selective_page_loader(const char* filepath, std::size_t batch_pages_) :
+	ifs{ filepath, std::ios::in | std::ios::binary },
+	num_pages{ 0 },
+	batch_pages{ (batch_pages_ > 0) ? batch_pages_ : 1 }
+{
+	if (!ifs.is_open())
+		return;
+	ifs.seekg(0, std::ios::end);
+	num_pages = static_cast<std::size_t>(ifs.tellg()) / PageSize;
+	buffer = make_aligned_buffer(batch_pages * PageSize);
+}
+
+SELECTIVE_PAGE_LOADER_TEMPLATE
+bool SELECTIVE_PAGE_LOADER::read(std::size_t first_page, std::size_t count, void* dst, page_load_stats& stats)
+{
+	if (first_page + count > num_pages) {
+		stats.failed = true;
+		return false;
+	}
+	ifs.clear();
+	ifs.seekg(static_cast<std::streamoff>(first_page * PageSize), std::ios::beg);
+	ifs.read(static_cast<char*>(dst), static_cast<std::streamsize>(count * PageSize));
+	if (static_cast<std::size_t>(ifs.gcount()) != count * PageSize) {
+		stats.failed = true;
+		return false;
+	}
+	++stats.num_reads;
+	stats.num_pages_read += count;
+	stats.bytes_read += static_cast<std::uint64_t>(count * PageSize);
+	return true;
+}
+
+SELECTIVE_PAGE_LOADER_TEMPLATE
+template <typename FnTy>
+page_load_stats SELECTIVE_PAGE_LOADER::load(const std::vector<page_range>& ranges, FnTy fn)
+{
+	page_load_stats stats{ 0, 0, 0, !is_open() };
+	if (stats.failed)
+		return stats;
+	for (const page_range& range : ranges) {
+		for (std::size_t offset = 0; offset < range.num_pages; offset += batch_pages) {
+			const std::size_t count = std::min(batch_pages, range.num_pages - offset);
+			if (!read(range.first_page + offset, count, buffer.get(), stats))
+				return stats;
+			fn(range.first_page + offset, reinterpret_cast<const page_t*>(buffer.get()), count);
+		}
+	}
+	return stats;
+}
+
+SELECTIVE_PAGE_LOADER_TEMPLATE
+page_load_stats SELECTIVE_PAGE_LOADER::load_into(const std::vector<page_range>& ranges, page_t* pages)
+{
+	page_load_stats stats{ 0, 0, 0, !is_open() };
+	if (stats.failed)
+		return stats;
+	for (const page_range& range : ranges)
+		if (!read(range.first_page, range.num_pages, pages + range.first_page, stats))
+			break;
+	return stats;
+}
+
+#undef SELECTIVE_PAGE_LOADER
+#undef SELECTIVE_PAGE_LOADER_TEMPLATE
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_IO_SELECTIVE_PAGE_LOADER_H_
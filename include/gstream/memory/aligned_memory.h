@@ -0,0 +1,75 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/memory
+*	@file		aligned_memory.h
+*	@brief		Portable aligned allocation helpers for page-sized buffers
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_MEMORY_ALIGNED_MEMORY_H_
+#define _GSTREAM_MEMORY_ALIGNED_MEMORY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <gstream/mpl.h>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#if _WIN32 || _WIN64
+#include <malloc.h>
+#endif
+
+namespace gstream {
+
+// Typical alignment required by unbuffered (O_DIRECT / FILE_FLAG_NO_BUFFERING) I/O
+constexpr std::size_t DIRECT_IO_ALIGNMENT = 4096u;
+
+inline void* aligned_malloc(std::size_t size, std::size_t alignment)
+{
+#if _WIN32 || _WIN64
+	return _aligned_malloc(size, alignment);
+#else
+	void* ptr = nullptr;
+	if (0 != posix_memalign(&ptr, alignment, size))
+		return nullptr;
+	return ptr;
+#endif
+}
+
+inline void aligned_free(void* ptr)
+{
+#if _WIN32 || _WIN64
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+inline std::size_t align_up(std::size_t size, std::size_t alignment)
+{
+	return (size + alignment - 1) / alignment * alignment;
+}
+
+struct aligned_deleter {
+	void operator()(void* ptr) const
+	{
+		aligned_free(ptr);
+	}
+};
+
+// Owning pointer to a zero-filled, aligned block of raw memory
+using aligned_buffer_ptr = std::unique_ptr<uint8_t[], aligned_deleter>;
+
+inline aligned_buffer_ptr make_aligned_buffer(std::size_t size, std::size_t alignment = DIRECT_IO_ALIGNMENT)
+{
+	void* ptr = aligned_malloc(align_up(size, alignment), alignment);
+	if (ptr)
+		memset(ptr, 0, align_up(size, alignment));
+	return aligned_buffer_ptr{ static_cast<uint8_t*>(ptr) };
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_MEMORY_ALIGNED_MEMORY_H_
@@ -0,0 +1,253 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/memory
+*	@file		numa.h
+*	@brief		NUMA topology discovery, memory binding and thread pinning
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_MEMORY_NUMA_H_
+#define _GSTREAM_MEMORY_NUMA_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if _WIN32 || _WIN64
+#ifndef NOMINMAX
+#define NOMINMAX // std::min/std::max in the rest of the library
+#endif
+#include <Windows.h>
+#else
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* ---------------------------------------------------------------
+**
+** NUMA helpers without a libnuma dependency
+** - Linux: topology from /sys/devices/system/node, mbind(2) through
+**   syscall(2), pinning with pthread_setaffinity_np.
+** - Windows: GetNumaNodeProcessorMask and SetThreadAffinityMask;
+**   memory placement relies on first-touch.
+** A machine without NUMA information is reported as a single node
+** owning every hardware thread.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+using numa_node_t = std::uint32_t;
+
+class numa_topology {
+public:
+	numa_topology()
+	{
+		detect();
+	}
+
+	inline numa_node_t number_of_nodes() const
+	{
+		return static_cast<numa_node_t>(node_cpus.size());
+	}
+	inline const std::vector<int>& cpus(numa_node_t node) const
+	{
+		return node_cpus[node];
+	}
+	// Node id used by the OS (nodes may be sparse, e.g. 0 and 2)
+	inline int os_node_id(numa_node_t node) const
+	{
+		return node_ids[node];
+	}
+
+	static const numa_topology& instance()
+	{
+		static numa_topology topology;
+		return topology;
+	}
+
+protected:
+	void detect();
+	void fallback();
+#if !(_WIN32 || _WIN64)
+	static std::vector<int> parse_cpu_list(const std::string& list);
+#endif
+
+	std::vector<std::vector<int>> node_cpus;
+	std::vector<int>              node_ids;
+};
+
+inline void numa_topology::fallback()
+{
+	node_cpus.assign(1, std::vector<int>{});
+	node_ids.assign(1, 0);
+	unsigned num_cpus = std::thread::hardware_concurrency();
+	for (unsigned cpu = 0; cpu < ((num_cpus > 0) ? num_cpus : 1); ++cpu)
+		node_cpus[0].push_back(static_cast<int>(cpu));
+}
+
+#if _WIN32 || _WIN64
+inline void numa_topology::detect()
+{
+	ULONG highest = 0;
+	if (!GetNumaHighestNodeNumber(&highest)) {
+		fallback();
+		return;
+	}
+	for (ULONG node = 0; node <= highest; ++node) {
+		ULONGLONG mask = 0;
+		if (!GetNumaNodeProcessorMask(static_cast<UCHAR>(node), &mask) || 0 == mask)
+			continue;
+		std::vector<int> cpus;
+		for (int cpu = 0; cpu < 64; ++cpu)
+			if (mask & (1ull << cpu))
+				cpus.push_back(cpu);
+		node_cpus.push_back(cpus);
+		node_ids.push_back(static_cast<int>(node));
+	}
+	if (node_cpus.empty())
+		fallback();
+}
+#else
+inline std::vector<int> numa_topology::parse_cpu_list(const std::string& list)
+{
+	// e.g. "0-3,8-11"
+	std::vector<int> cpus;
+	std::size_t pos = 0;
+	while (pos < list.size()) {
+		std::size_t end = list.find(',', pos);
+		if (end == std::string::npos)
+			end = list.size();
+		std::string range = list.substr(pos, end - pos);
+		std::size_t dash = range.find('-');
+		if (!range.empty() && range[0] >= '0' && range[0] <= '9') {
+			int first = std::atoi(range.c_str());
+			int last = (dash == std::string::npos) ? first : std::atoi(range.c_str() + dash + 1);
+			for (int cpu = first; cpu <= last; ++cpu)
+				cpus.push_back(cpu);
+		}
+		pos = end + 1;
+	}
+	return cpus;
+}
+
+inline void numa_topology::detect()
+{
+	std::ifstream online{ "/sys/devices/system/node/online" };
+	std::string list;
+	if (!online.is_open() || !std::getline(online, list)) {
+		fallback();
+		return;
+	}
+	for (int node : parse_cpu_list(list)) {
+		std::ifstream cpulist{ "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist" };
+		std::string cpus;
+		if (!cpulist.is_open() || !std::getline(cpulist, cpus) || parse_cpu_list(cpus).empty())
+			continue; // memory-only node
+		node_cpus.push_back(parse_cpu_list(cpus));
+		node_ids.push_back(node);
+	}
+	if (node_cpus.empty())
+		fallback();
+}
+#endif
+
+/// Pin the calling thread to the hardware threads of a node
+inline bool pin_thread_to_node(numa_node_t node, const numa_topology& topology = numa_topology::instance())
+{
+	if (node >= topology.number_of_nodes())
+		return false;
+#if _WIN32 || _WIN64
+	DWORD_PTR mask = 0;
+	for (int cpu : topology.cpus(node))
+		if (cpu < static_cast<int>(sizeof(DWORD_PTR) * 8))
+			mask |= (static_cast<DWORD_PTR>(1) << cpu);
+	return 0 != SetThreadAffinityMask(GetCurrentThread(), mask);
+#else
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (int cpu : topology.cpus(node))
+		if (cpu < CPU_SETSIZE)
+			CPU_SET(cpu, &set);
+	return 0 == pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+#endif
+}
+
+/// Run fn(node, worker, num_workers_in_node) on threads pinned to every node and wait for them.
+// threads_per_node = 0: one thread per hardware thread of the node
+template <typename FnTy>
+void run_on_nodes(FnTy fn, std::size_t threads_per_node = 0, const numa_topology& topology = numa_topology::instance())
+{
+	std::vector<std::thread> workers;
+	for (numa_node_t node = 0; node < topology.number_of_nodes(); ++node) {
+		const std::size_t num_workers = (threads_per_node > 0) ? threads_per_node : topology.cpus(node).size();
+		for (std::size_t worker = 0; worker < num_workers; ++worker)
+			workers.emplace_back([&topology, fn, node, worker, num_workers]() {
+				pin_thread_to_node(node, topology);
+				fn(node, worker, num_workers);
+			});
+	}
+	for (auto& worker : workers)
+		worker.join();
+}
+
+enum class numa_policy_t {
+	bind,       // all pages on one node
+	interleave, // OS pages round-robin over the nodes
+};
+
+/// Bind a page-aligned address range to node(s) with mbind(2).
+// Returns false where the system call is not available; callers fall back to first-touch.
+inline bool numa_bind_memory(void* addr, std::size_t length, numa_policy_t policy, numa_node_t node, const numa_topology& topology = numa_topology::instance())
+{
+#if (_WIN32 || _WIN64) || !defined(SYS_mbind)
+	(void)addr; (void)length; (void)policy; (void)node; (void)topology;
+	return false;
+#else
+	constexpr int MpolBind = 2;
+	constexpr int MpolInterleave = 3;
+	constexpr std::size_t BitsPerWord = sizeof(unsigned long) * 8;
+	std::vector<unsigned long> mask(4, 0ul);
+	auto set_node = [&](int os_node) {
+		std::size_t bit = static_cast<std::size_t>(os_node);
+		if (bit / BitsPerWord >= mask.size())
+			mask.resize(bit / BitsPerWord + 1, 0ul);
+		mask[bit / BitsPerWord] |= (1ul << (bit % BitsPerWord));
+	};
+	if (policy == numa_policy_t::interleave) {
+		for (numa_node_t n = 0; n < topology.number_of_nodes(); ++n)
+			set_node(topology.os_node_id(n));
+	}
+	else {
+		if (node >= topology.number_of_nodes())
+			return false;
+		set_node(topology.os_node_id(node));
+	}
+	long ret = syscall(SYS_mbind, addr, length, (policy == numa_policy_t::interleave) ? MpolInterleave : MpolBind,
+		mask.data(), static_cast<unsigned long>(mask.size() * BitsPerWord + 1), 0u);
+	return 0 == ret;
+#endif
+}
+
+inline std::size_t os_page_size()
+{
+#if _WIN32 || _WIN64
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return static_cast<std::size_t>(info.dwPageSize);
+#else
+	long size = sysconf(_SC_PAGESIZE);
+	return (size > 0) ? static_cast<std::size_t>(size) : 4096u;
+#endif
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_MEMORY_NUMA_H_
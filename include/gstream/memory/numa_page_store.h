@@ -0,0 +1,319 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/memory
+*	@file		numa_page_store.h
+*	@brief		NUMA-aware page store and node-pinned page scheduler
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_MEMORY_NUMA_PAGE_STORE_H_
+#define _GSTREAM_MEMORY_NUMA_PAGE_STORE_H_
+
+#include <gstream/memory/numa.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+/* ---------------------------------------------------------------
+**
+** numa_page_store
+** A contiguous array of pages whose memory is spread over the NUMA
+** nodes instead of landing on the node of the loading thread:
+** - partition:  page range k is bound to node k (mbind MPOL_BIND)
+** - interleave: OS pages round-robin over the nodes (MPOL_INTERLEAVE)
+** The store is populated by threads pinned to the owning node, so
+** first-touch gives the same placement where mbind is unavailable.
+**
+** numa_page_scheduler
+** Runs a page-range kernel with workers pinned to the node which
+** owns the pages they process; each node hands out chunks of its
+** own range dynamically.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+enum class numa_placement_t {
+	partition,
+	interleave,
+};
+
+template <typename PageTy>
+class numa_page_store {
+public:
+	using page_t = PageTy;
+	static constexpr std::size_t PageSize = page_t::PageSize;
+
+	explicit numa_page_store(numa_placement_t placement_ = numa_placement_t::partition, const numa_topology& topology_ = numa_topology::instance());
+	numa_page_store(const numa_page_store&) = delete;
+	numa_page_store& operator=(const numa_page_store&) = delete;
+	~numa_page_store();
+
+	/// Allocate: place zero-filled storage for num_pages pages
+	bool allocate(std::size_t num_pages);
+	/// Load: read a .pages file; each node reads its own page range
+	bool load(const char* filepath);
+	/// Assign: copy pages from a contiguous container (e.g. the std::vector returned by read_pages)
+	template <typename PageContTy>
+	bool assign(const PageContTy& pages);
+
+	inline page_t& operator[](std::size_t page_id)
+	{
+		return pages[page_id];
+	}
+	inline const page_t& operator[](std::size_t page_id) const
+	{
+		return pages[page_id];
+	}
+	inline page_t* data()
+	{
+		return pages;
+	}
+	inline page_t* begin()
+	{
+		return pages;
+	}
+	inline page_t* end()
+	{
+		return pages + num_pages;
+	}
+	inline std::size_t size() const
+	{
+		return num_pages;
+	}
+	inline numa_placement_t placement() const
+	{
+		return policy;
+	}
+	inline const numa_topology& topology() const
+	{
+		return topo;
+	}
+
+	/// Node range: pages owned by a node (partition), or an even share of the pages (interleave)
+	std::pair<std::size_t, std::size_t> node_range(numa_node_t node) const;
+	numa_node_t node_of(std::size_t page_id) const;
+
+protected:
+	void release();
+	// Run fn(first_page, last_page) on threads pinned to the node of each range.
+	// first_touch: with interleave, hand out OS pages round-robin so that the toucher decides the node
+	template <typename FnTy>
+	void populate(FnTy fn, bool first_touch);
+
+	numa_placement_t      policy;
+	const numa_topology&  topo;
+	page_t*               pages;
+	std::size_t           num_pages;
+	std::size_t           mapped_size;
+	std::vector<std::size_t> boundaries; // node k owns [boundaries[k], boundaries[k + 1])
+};
+
+#define NUMA_PAGE_STORE_TEMPLATE template <typename PageTy>
+#define NUMA_PAGE_STORE numa_page_store<PageTy>
+
+NUMA_PAGE_STORE_TEMPLATE
+NUMA_PAGE_STORE::numa_page_store(numa_placement_t placement_, const numa_topology& topology_) :
+	policy{ placement_ },
+	topo{ topology_ },
+	pages{ nullptr },
+	num_pages{ 0 },
+	mapped_size{ 0 }
+{
+}
+
+NUMA_PAGE_STORE_TEMPLATE
+NUMA_PAGE_STORE::~numa_page_store()
+{
+	release();
+}
+
+NUMA_PAGE_STORE_TEMPLATE
+void NUMA_PAGE_STORE::release()
+{
+	if (pages) {
+#if _WIN32 || _WIN64
+		VirtualFree(pages, 0, MEM_RELEASE);
+#else
+		munmap(pages, mapped_size);
+#endif
+	}
+	pages = nullptr;
+	num_pages = 0;
+	mapped_size = 0;
+}
+
+NUMA_PAGE_STORE_TEMPLATE
+bool NUMA_PAGE_STORE::allocate(std::size_t num_pages_)
+{
+	release();
+	if (0 == num_pages_)
+		return false;
+
+	// Untouched, OS-page aligned memory, so that the placement below decides the node of every OS page
+	const std::size_t os_page = os_page_size();
+	mapped_size = (num_pages_ * PageSize + os_page - 1) / os_page * os_page;
+#if _WIN32 || _WIN64
+	void* addr = VirtualAlloc(nullptr, mapped_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	if (!addr) {
+		mapped_size = 0;
+		return false;
+	}
+#else
+	void* addr = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (addr == MAP_FAILED) {
+		mapped_size = 0;
+		return false;
+	}
+#endif
+	pages = static_cast<page_t*>(addr);
+	num_pages = num_pages_;
+
+	// Node boundaries on OS page granularity
+	const numa_node_t num_nodes = topo.number_of_nodes();
+	const std::size_t pages_per_os_page = (PageSize >= os_page) ? 1 : (os_page / PageSize);
+	const std::size_t num_units = (num_pages + pages_per_os_page - 1) / pages_per_os_page;
+	boundaries.assign(num_nodes + 1, num_pages);
+	for (numa_node_t node = 0; node < num_nodes; ++node)
+		boundaries[node] = std::min(num_pages, (num_units * node / num_nodes) * pages_per_os_page);
+
+	if (policy == numa_placement_t::interleave) {
+		numa_bind_memory(pages, mapped_size, numa_policy_t::interleave, 0, topo);
+	}
+	else {
+		for (numa_node_t node = 0; node < num_nodes; ++node) {
+			uint8_t* first = reinterpret_cast<uint8_t*>(pages + boundaries[node]);
+			uint8_t* last = (node + 1 == num_nodes) ? reinterpret_cast<uint8_t*>(pages) + mapped_size : reinterpret_cast<uint8_t*>(pages + boundaries[node + 1]);
+			if (last > first)
+				numa_bind_memory(first, static_cast<std::size_t>(last - first), numa_policy_t::bind, node, topo);
+		}
+	}
+
+	// First touch by the owners (a no-op for the placement if mbind succeeded)
+	populate([this](std::size_t first, std::size_t last) {
+		memset(static_cast<void*>(pages + first), 0, (last - first) * PageSize);
+	}, true);
+	return true;
+}
+
+NUMA_PAGE_STORE_TEMPLATE
+template <typename FnTy>
+void NUMA_PAGE_STORE::populate(FnTy fn, bool first_touch)
+{
+	const std::size_t os_page = os_page_size();
+	const std::size_t pages_per_os_page = (PageSize >= os_page) ? 1 : (os_page / PageSize);
+	const numa_node_t num_nodes = topo.number_of_nodes();
+	run_on_nodes([&](numa_node_t node, std::size_t worker, std::size_t num_workers) {
+		if (first_touch && policy == numa_placement_t::interleave) {
+			// OS page i is touched by node (i % num_nodes)
+			const std::size_t num_units = (num_pages + pages_per_os_page - 1) / pages_per_os_page;
+			for (std::size_t unit = node + worker * num_nodes; unit < num_units; unit += num_nodes * num_workers)
+				fn(unit * pages_per_os_page, std::min(num_pages, (unit + 1) * pages_per_os_page));
+			return;
+		}
+		const std::size_t first = boundaries[node];
+		const std::size_t count = boundaries[node + 1] - first;
+		const std::size_t begin = first + count * worker / num_workers;
+		const std::size_t end = first + count * (worker + 1) / num_workers;
+		if (end > begin)
+			fn(begin, end);
+	}, 0, topo);
+}
+
+NUMA_PAGE_STORE_TEMPLATE
+bool NUMA_PAGE_STORE::load(const char* filepath)
+{
+	std::ifstream ifs{ filepath, std::ios::in | std::ios::binary };
+	if (!ifs.is_open())
+		return false;
+	ifs.seekg(0, std::ios::end);
+	const std::size_t file_size = static_cast<std::size_t>(ifs.tellg());
+	ifs.close();
+	if (!allocate(file_size / PageSize))
+		return false;
+
+	std::atomic<bool> failed{ false };
+	std::string path{ filepath };
+	populate([&](std::size_t first, std::size_t last) {
+		std::ifstream in{ path, std::ios::in | std::ios::binary };
+		in.seekg(static_cast<std::streamoff>(first * PageSize), std::ios::beg);
+		in.read(reinterpret_cast<char*>(pages + first), static_cast<std::streamsize>((last - first) * PageSize));
+		if (static_cast<std::size_t>(in.gcount()) != (last - first) * PageSize)
+			failed = true;
+	}, false);
+	return !failed;
+}
+
+NUMA_PAGE_STORE_TEMPLATE
+template <typename PageContTy>
+bool NUMA_PAGE_STORE::assign(const PageContTy& source)
+{
+	if (!allocate(source.size()))
+		return false;
+	populate([&](std::size_t first, std::size_t last) {
+		memcpy(static_cast<void*>(pages + first), &source[first], (last - first) * PageSize);
+	}, false);
+	return true;
+}
+
+NUMA_PAGE_STORE_TEMPLATE
+std::pair<std::size_t, std::size_t> NUMA_PAGE_STORE::node_range(numa_node_t node) const
+{
+	if (num_pages == 0 || node >= topo.number_of_nodes())
+		return std::make_pair(num_pages, num_pages);
+	return std::make_pair(boundaries[node], boundaries[node + 1]);
+}
+
+NUMA_PAGE_STORE_TEMPLATE
+numa_node_t NUMA_PAGE_STORE::node_of(std::size_t page_id) const
+{
+	if (policy == numa_placement_t::interleave) {
+		const std::size_t os_page = os_page_size();
+		const std::size_t pages_per_os_page = (PageSize >= os_page) ? 1 : (os_page / PageSize);
+		return static_cast<numa_node_t>((page_id / pages_per_os_page) % topo.number_of_nodes());
+	}
+	numa_node_t node = 0;
+	while (node + 1 < topo.number_of_nodes() && boundaries[node + 1] <= page_id)
+		++node;
+	return node;
+}
+
+#undef NUMA_PAGE_STORE
+#undef NUMA_PAGE_STORE_TEMPLATE
+
+class numa_page_scheduler {
+public:
+	// threads_per_node = 0: one worker per hardware thread of the node
+	explicit numa_page_scheduler(std::size_t threads_per_node_ = 0, std::size_t chunk_pages_ = 64) :
+		threads_per_node{ threads_per_node_ },
+		chunk_pages{ (chunk_pages_ > 0) ? chunk_pages_ : 1 }
+	{
+	}
+
+	/// For each page range: fn(first_page, last_page, node), executed on a worker pinned to 'node'
+	template <typename PageStoreTy, typename FnTy>
+	void for_each_page_range(PageStoreTy& store, FnTy fn) const
+	{
+		const numa_topology& topology = store.topology();
+		std::vector<std::atomic<std::size_t>> cursors(topology.number_of_nodes());
+		for (numa_node_t node = 0; node < topology.number_of_nodes(); ++node)
+			cursors[node] = store.node_range(node).first;
+		const std::size_t chunk = chunk_pages;
+		run_on_nodes([&](numa_node_t node, std::size_t, std::size_t) {
+			const std::size_t last = store.node_range(node).second;
+			for (std::size_t first = cursors[node].fetch_add(chunk); first < last; first = cursors[node].fetch_add(chunk))
+				fn(first, std::min(first + chunk, last), node);
+		}, threads_per_node, topology);
+	}
+
+protected:
+	std::size_t threads_per_node;
+	std::size_t chunk_pages;
+};
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_MEMORY_NUMA_PAGE_STORE_H_
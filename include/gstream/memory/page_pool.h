@@ -0,0 +1,344 @@
+/** -------------------------------------------------------------------
+*	@project	LibGStream
+*	@location	gstream/memory
+*	@file		page_pool.h
+*	@brief		Huge page backed pool of page-sized blocks for page builders and buffers
+*	@author		Seyeon Oh (vee@dgist.ac.kr)
+*	@version	1.0, 16/10/2026
+* ----------------------------------------------------------------- */
+
+#ifndef _GSTREAM_MEMORY_PAGE_POOL_H_
+#define _GSTREAM_MEMORY_PAGE_POOL_H_
+
+#include <gstream/memory/aligned_memory.h>
+#include <gstream/memory/numa.h>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+/* ---------------------------------------------------------------
+**
+** Huge page chunks
+** allocate_huge_chunk() maps a chunk of a multiple of huge_page_size()
+** bytes and asks for huge pages:
+** - Linux: a huge page aligned anonymous mapping with
+**   madvise(MADV_HUGEPAGE) (transparent huge pages)
+** - Windows: VirtualAlloc(MEM_LARGE_PAGES), which needs the "Lock
+**   pages in memory" privilege; ordinary pages otherwise
+** 'huge' reports whether the request was accepted. The chunk is
+** zero-filled either way.
+**
+** page_pool<BlockSize, Alignment>
+** Fixed-size blocks carved out of huge page chunks, with the freed
+** blocks kept in an intrusive free list (the link is stored in the
+** block itself). Chunks are only mapped when the free list and the
+** current chunk are both empty and are unmapped with the pool, so a
+** block acquired after warm-up never reaches the general-purpose
+** allocator. instance() is the pool shared by the process for a
+** block size.
+**
+** pooled_ptr<T, PoolTy>
+** The owning handle of an object constructed in a block by
+** make_pooled<T>(pool); the object is destroyed and the block goes
+** back to the pool with the handle. The generators of pagedb.h draw
+** their page builders and edge list buffers from the pool of their
+** page size; every worker of generate_parallel() owns a generator,
+** hence a builder of its own.
+**
+** ------------------------------------------------------------ */
+
+namespace gstream {
+
+inline std::size_t huge_page_size()
+{
+#if _WIN32 || _WIN64
+	const SIZE_T size = GetLargePageMinimum();
+	return (size > 0) ? static_cast<std::size_t>(size) : (2u << 20);
+#else
+	std::ifstream ifs{ "/sys/kernel/mm/transparent_hugepage/hpage_pmd_size" };
+	std::size_t size = 0;
+	if (ifs >> size && size > 0)
+		return size;
+	return 2u << 20;
+#endif
+}
+
+/// Allocate huge chunk: size must be a multiple of huge_page_size(); nullptr on failure
+inline void* allocate_huge_chunk(std::size_t size, bool& huge)
+{
+	huge = false;
+#if _WIN32 || _WIN64
+	void* addr = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+	if (addr) {
+		huge = true;
+		return addr;
+	}
+	return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+	// Over-map by a huge page and trim both ends to get a huge page aligned region
+	const std::size_t alignment = huge_page_size();
+	void* addr = mmap(nullptr, size + alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (addr == MAP_FAILED)
+		return nullptr;
+	const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(addr);
+	const std::uintptr_t aligned = (first + alignment - 1) / alignment * alignment;
+	if (aligned > first)
+		munmap(addr, aligned - first);
+	if (first + alignment > aligned)
+		munmap(reinterpret_cast<void*>(aligned + size), first + alignment - aligned);
+#ifdef MADV_HUGEPAGE
+	huge = (0 == madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE));
+#endif
+	return reinterpret_cast<void*>(aligned);
+#endif
+}
+
+inline void release_huge_chunk(void* addr, std::size_t size)
+{
+#if _WIN32 || _WIN64
+	(void)size;
+	VirtualFree(addr, 0, MEM_RELEASE);
+#else
+	munmap(addr, size);
+#endif
+}
+
+// Blocks are cache line aligned by default; page-sized blocks of a power of two size are also aligned to their size
+template <std::size_t BlockSize, std::size_t Alignment = 64>
+class page_pool {
+public:
+	static_assert(BlockSize >= sizeof(void*), "page_pool: a block must be able to hold the free list link");
+	static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0 && Alignment <= 4096, "page_pool: the alignment must be a power of two up to 4KB");
+	static constexpr std::size_t BlockAlignment = Alignment;
+	static constexpr std::size_t BlockStride = (BlockSize + Alignment - 1) / Alignment * Alignment;
+
+	// chunk_size_ = 0: one huge page, or as many as a block needs
+	explicit page_pool(std::size_t chunk_size_ = 0);
+	page_pool(const page_pool&) = delete;
+	page_pool& operator=(const page_pool&) = delete;
+	~page_pool();
+
+	/// Instance: the pool shared by the process for this block size
+	static page_pool& instance()
+	{
+		static page_pool pool;
+		return pool;
+	}
+
+	/// Acquire: an uninitialized block; nullptr if a chunk cannot be mapped
+	void* acquire();
+	/// Release: give a block of this pool back
+	void release(void* block);
+	/// Reserve: map chunks until num_blocks blocks can be acquired without mapping
+	bool reserve(std::size_t num_blocks);
+
+	inline std::size_t chunk_size() const
+	{
+		return chunk_bytes;
+	}
+	inline std::size_t number_of_chunks() const
+	{
+		std::lock_guard<std::mutex> guard{ lock };
+		return chunks.size();
+	}
+	// The number of blocks which can be acquired without mapping a chunk
+	inline std::size_t number_of_available_blocks() const
+	{
+		std::lock_guard<std::mutex> guard{ lock };
+		return num_free + static_cast<std::size_t>(chunk_end - cursor) / BlockStride;
+	}
+	// True if every chunk was mapped with huge pages
+	inline bool huge_page_backed() const
+	{
+		std::lock_guard<std::mutex> guard{ lock };
+		return all_huge;
+	}
+
+protected:
+	struct free_block {
+		free_block* next;
+	};
+	struct chunk {
+		void*       addr;
+		std::size_t size;
+	};
+	bool grow();
+
+	mutable std::mutex lock;
+	std::size_t        chunk_bytes;
+	free_block*        free_list{ nullptr };
+	std::size_t        num_free{ 0 };
+	std::uint8_t*      cursor{ nullptr };    // next block never handed out in the current chunk
+	std::uint8_t*      chunk_end{ nullptr };
+	std::vector<chunk> chunks;
+	bool               all_huge{ true };
+};
+
+#define PAGE_POOL_TEMPLATE template <std::size_t BlockSize, std::size_t Alignment>
+#define PAGE_POOL page_pool<BlockSize, Alignment>
+
+PAGE_POOL_TEMPLATE
+PAGE_POOL::page_pool(std::size_t chunk_size_) :
+	chunk_bytes{ align_up((chunk_size_ > BlockStride) ? chunk_size_ : BlockStride, huge_page_size()) }
+{
+	chunks.reserve(16);
+}
+
+PAGE_POOL_TEMPLATE
+PAGE_POOL::~page_pool()
+{
+	for (const chunk& c : chunks)
+		release_huge_chunk(c.addr, c.size);
+}
+
+PAGE_POOL_TEMPLATE
+void* PAGE_POOL::acquire()
+{
+	std::lock_guard<std::mutex> guard{ lock };
+	if (free_list) {
+		free_block* block = free_list;
+		free_list = block->next;
+		--num_free;
+		return block;
+	}
+	if (cursor == chunk_end && !grow())
+		return nullptr;
+	void* block = cursor;
+	cursor += BlockStride;
+	return block;
+}
+
+PAGE_POOL_TEMPLATE
+void PAGE_POOL::release(void* block)
+{
+	if (!block)
+		return;
+	std::lock_guard<std::mutex> guard{ lock };
+	free_block* link = static_cast<free_block*>(block);
+	link->next = free_list;
+	free_list = link;
+	++num_free;
+}
+
+PAGE_POOL_TEMPLATE
+bool PAGE_POOL::reserve(std::size_t num_blocks)
+{
+	std::lock_guard<std::mutex> guard{ lock };
+	while (num_free + static_cast<std::size_t>(chunk_end - cursor) / BlockStride < num_blocks) {
+		if (!grow())
+			return false;
+	}
+	return true;
+}
+
+// Requires the lock
+PAGE_POOL_TEMPLATE
+bool PAGE_POOL::grow()
+{
+	bool huge = false;
+	void* addr = allocate_huge_chunk(chunk_bytes, huge);
+	if (!addr)
+		return false;
+	chunks.push_back(chunk{ addr, chunk_bytes });
+	all_huge = all_huge && huge;
+
+	// The rest of the current chunk goes to the free list
+	for (; cursor != nullptr && cursor + BlockStride <= chunk_end; cursor += BlockStride) {
+		free_block* link = reinterpret_cast<free_block*>(cursor);
+		link->next = free_list;
+		free_list = link;
+		++num_free;
+	}
+	cursor = static_cast<std::uint8_t*>(addr);
+	chunk_end = cursor + (chunk_bytes / BlockStride) * BlockStride;
+	return true;
+}
+
+#undef PAGE_POOL
+#undef PAGE_POOL_TEMPLATE
+
+template <typename T, typename PoolTy>
+class pooled_ptr {
+public:
+	using element_type = T;
+	using pool_t = PoolTy;
+
+	pooled_ptr() = default;
+	pooled_ptr(T* object_, pool_t* pool_) :
+		object{ object_ },
+		pool{ pool_ }
+	{
+
+	}
+	pooled_ptr(const pooled_ptr&) = delete;
+	pooled_ptr& operator=(const pooled_ptr&) = delete;
+	pooled_ptr(pooled_ptr&& other) :
+		object{ other.object },
+		pool{ other.pool }
+	{
+		other.object = nullptr;
+	}
+	pooled_ptr& operator=(pooled_ptr&& other)
+	{
+		if (this != &other) {
+			reset();
+			object = other.object;
+			pool = other.pool;
+			other.object = nullptr;
+		}
+		return *this;
+	}
+	~pooled_ptr()
+	{
+		reset();
+	}
+
+	/// Reset: destroy the object and give its block back to the pool
+	void reset()
+	{
+		if (object) {
+			object->~T();
+			pool->release(object);
+			object = nullptr;
+		}
+	}
+
+	inline T* get() const
+	{
+		return object;
+	}
+	inline T& operator*() const
+	{
+		return *object;
+	}
+	inline T* operator->() const
+	{
+		return object;
+	}
+	inline explicit operator bool() const
+	{
+		return object != nullptr;
+	}
+
+protected:
+	T*      object{ nullptr };
+	pool_t* pool{ nullptr };
+};
+
+/// Make pooled: construct a T (value-initialized without arguments) in a block of the pool; throws std::bad_alloc like std::make_shared
+template <typename T, typename PoolTy, typename... ArgsTy>
+pooled_ptr<T, PoolTy> make_pooled(PoolTy& pool, ArgsTy&&... args)
+{
+	static_assert(sizeof(T) <= PoolTy::BlockStride, "make_pooled: the object does not fit in a block");
+	static_assert(alignof(T) <= PoolTy::BlockAlignment, "make_pooled: the object needs a stricter alignment than the pool");
+	void* block = pool.acquire();
+	if (!block)
+		throw std::bad_alloc();
+	return pooled_ptr<T, PoolTy>{ ::new (block) T(std::forward<ArgsTy>(args)...), &pool };
+}
+
+} // !namespace gstream
+
+#endif // !_GSTREAM_MEMORY_PAGE_POOL_H_
@@ -0,0 +1,57 @@
+#include <gstream/datatype/pagedb_compaction.h>
+#include <fstream>
+
+// Define meta parameter for page type (same as PageDatabaseReader)
+using vertex_id_t = uint8_t;
+using page_id_t = uint8_t;
+using record_offset_t = uint8_t;
+using slot_offset_t = uint8_t;
+using record_size_t = uint8_t;
+using edge_payload_t = uint8_t;
+using vertex_payload_t = uint8_t;
+constexpr size_t PageSize = 64;
+
+// Define page type
+using page_t = gstream::slotted_page<vertex_id_t, page_id_t, record_offset_t, slot_offset_t, record_size_t, PageSize, edge_payload_t, vertex_payload_t>;
+using generator_traits = gstream::generator_traits<page_t>;
+
+using page_cont_t = std::vector<page_t>;
+using rid_tuple_t = generator_traits::rid_tuple_t;
+using rid_table_t = generator_traits::rid_table_t;
+using compactor_t = gstream::pagedb_compactor<page_t>;
+
+// Usage: PageDatabaseCompactor <in.pages> <in.rid_table> <out.pages> <out.rid_table> [in.overflow_pages] [num_threads]
+int main(int argc, char* argv[])
+{
+    if (argc < 5) {
+        printf("usage: %s <in.pages> <in.rid_table> <out.pages> <out.rid_table> [in.overflow_pages] [num_threads]\n", argv[0]);
+        return 1;
+    }
+
+    page_cont_t pages = gstream::read_pages<page_t, std::vector>(argv[1]);
+    rid_table_t rtable = gstream::read_rid_table<rid_tuple_t, std::vector>(argv[2]);
+    page_cont_t overflow_pages;
+    if (argc > 5)
+        overflow_pages = gstream::read_pages<page_t, std::vector>(argv[5]);
+    size_t num_threads = (argc > 6) ? static_cast<size_t>(atoi(argv[6])) : 0;
+
+    page_cont_t new_pages;
+    rid_table_t new_rtable;
+    compactor_t compactor{ num_threads };
+    auto result = compactor.compact(pages, overflow_pages, rtable, new_pages, new_rtable);
+    if (result.error != gstream::generator_error_t::success) {
+        printf("compaction failed\n");
+        return 1;
+    }
+
+    std::ofstream pages_ofs{ argv[3], std::ios::out | std::ios::binary };
+    gstream::write_pages(new_pages, pages_ofs);
+    std::ofstream rid_table_ofs{ argv[4], std::ios::out | std::ios::binary };
+    gstream::write_rid_table(new_rtable, rid_table_ofs);
+
+    printf("# vertices: %llu\n", static_cast<unsigned long long>(result.num_vertices));
+    printf("# pages: %llu (+%llu overflow) -> %llu\n", static_cast<unsigned long long>(result.num_old_pages),
+        static_cast<unsigned long long>(result.num_overflow_pages), static_cast<unsigned long long>(result.num_new_pages));
+    printf("# fill factor: %.3f -> %.3f\n", result.old_fill_factor, result.new_fill_factor);
+    return 0;
+}